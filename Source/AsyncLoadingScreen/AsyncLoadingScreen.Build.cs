@@ -38,11 +38,16 @@ public class AsyncLoadingScreen : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"MoviePlayer"
+				"MoviePlayer",
+				"ImageWrapper"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
-		
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("AssetRegistry");
+		}
 		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
@@ -14,28 +14,135 @@
 #include "SLetterboxLayout.h"
 #include "SSidebarLayout.h"
 #include "SDualSidebarLayout.h"
+#include "SLightweightLayout.h"
+#include "LoadingScreenTextPrewarmer.h"
+#include "LoadingScreenRenderPlan.h"
+#include "LoadingScreenProgress.h"
+#include "LoadingScreenLoadTimeModel.h"
+#include "LoadingScreenLoadTimeComparison.h"
+#include "LoadingScreenTextureStreaming.h"
+#include "LoadingScreenTrace.h"
+#include "SEarlyStartupSplash.h"
 #include "Framework/Application/SlateApplication.h"
 #include "AsyncLoadingScreenLibrary.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
 
 #define LOCTEXT_NAMESPACE "FAsyncLoadingScreenModule"
 
+DEFINE_LOG_CATEGORY(LogAsyncLoadingScreen);
+
+UE_TRACE_CHANNEL_DEFINE(AsyncLoadingScreenChannel);
+
+DEFINE_STAT(STAT_LiveWidgets);
+DEFINE_STAT(STAT_LiveBrushes);
+DEFINE_STAT(STAT_BrushSwaps);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DEFINE_STAT(STAT_AsyncLoadingScreenLLM);
+DEFINE_STAT(STAT_AsyncLoadingScreenSummaryLLM);
+
+// Tag the plugin's memory is tracked under, picked by RegisterLLMTag when the module starts up
+static ELLMTag AsyncLoadingScreenLLMTag = ELLMTag::ProjectTagEnd;
+
+ELLMTag GetAsyncLoadingScreenLLMTag()
+{
+	return AsyncLoadingScreenLLMTag;
+}
+
+/** Registers the project tag set in the engine config, unless the game already uses it */
+static void RegisterLLMTag()
+{
+	int32 ProjectTag = static_cast<int32>(ELLMTag::ProjectTagEnd);
+	GConfig->GetInt(TEXT("/Script/AsyncLoadingScreen.MemoryTracking"), TEXT("LLMTag"), ProjectTag, GEngineIni);
+
+	FLowLevelMemTracker& MemTracker = FLowLevelMemTracker::Get();
+	if (ProjectTag < static_cast<int32>(ELLMTag::ProjectTagStart) || ProjectTag > static_cast<int32>(ELLMTag::ProjectTagEnd))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("LLM tag %d isn't a project tag (%d to %d), the plugin's memory is tracked under UI."),
+			ProjectTag, static_cast<int32>(ELLMTag::ProjectTagStart), static_cast<int32>(ELLMTag::ProjectTagEnd));
+		AsyncLoadingScreenLLMTag = ELLMTag::UI;
+	}
+	else if (const TCHAR* TagName = MemTracker.FindTagName(ProjectTag))
+	{
+		// Registering it again would rename the game's tag
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("LLM tag %d is already registered as %s, the plugin's memory is tracked under UI. Set LLMTag in [/Script/AsyncLoadingScreen.MemoryTracking] to a free project tag."),
+			ProjectTag, TagName);
+		AsyncLoadingScreenLLMTag = ELLMTag::UI;
+	}
+	else
+	{
+		AsyncLoadingScreenLLMTag = static_cast<ELLMTag>(ProjectTag);
+		MemTracker.RegisterProjectTag(ProjectTag, TEXT("AsyncLoadingScreen"), GET_STATFNAME(STAT_AsyncLoadingScreenLLM), GET_STATFNAME(STAT_AsyncLoadingScreenSummaryLLM));
+	}
+}
+#endif
+
+DECLARE_CYCLE_STAT(TEXT("Setup Loading Screen"), STAT_SetupLoadingScreen, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Preload Loading Screen Assets"), STAT_PreloadLoadingScreenAssets, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Loading Screen Finished"), STAT_LoadingScreenFinished, STATGROUP_AsyncLoadingScreen);
+
+static TAutoConsoleVariable<float> CVarMaxFrameRate(
+	TEXT("AsyncLoadingScreen.MaxFrameRate"),
+	-1.0f,
+	TEXT("Overrides Max Frame Rate of the loading screen settings when not negative, so level load times can be compared against the cap.\n")
+	TEXT("Takes effect on the next loading screen."));
+
+static TAutoConsoleVariable<float> CVarMaxIdleFrameRate(
+	TEXT("AsyncLoadingScreen.MaxIdleFrameRate"),
+	-1.0f,
+	TEXT("Overrides Max Idle Frame Rate of the loading screen settings when not negative.\n")
+	TEXT("Takes effect on the next loading screen."));
+
 void FAsyncLoadingScreenModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	RegisterLLMTag();
+#endif
+	LLM_SCOPE_LOADING_SCREEN();
+
+	StreamableManager = MakeShared<FStreamableManager>();
+	TextPrewarmer = MakeShared<FLoadingScreenTextPrewarmer>();
+	LoadingProgress = MakeShared<FLoadingScreenProgress, ESPMode::ThreadSafe>();
+	LoadTimeModel = MakeShared<FLoadingScreenLoadTimeModel>();
+
+	// The map is usually only known once the loading screen is set up, the prediction starts from there
+	LoadTimeModel->OnMapLoadStarted().AddLambda([this](const FString& MapName)
+	{
+		LoadingProgress->SetExpectedMilestones(LoadTimeModel->GetExpectedMilestones(MapName));
+	});
 
 	if (!IsRunningDedicatedServer() && FSlateApplication::IsInitialized())
 	{
-		const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
-				
 		if (IsMoviePlayerEnabled())
 		{
 			GetMoviePlayer()->OnPrepareLoadingScreen().AddRaw(this, &FAsyncLoadingScreenModule::PreSetupLoadingScreen);
+			GetMoviePlayer()->OnMoviePlaybackFinished().AddRaw(this, &FAsyncLoadingScreenModule::OnLoadingScreenFinished);
 		}
 
 		// Prepare the startup screen, the PreSetupLoadingScreen callback won't be called
 		// if we've already explicitly setup the loading screen
-		SetupLoadingScreen(Settings->StartupLoadingScreen);
+		const FEarlyStartupSplashSettings EarlySplashSettings = FEarlyStartupSplashSettings::Load();
+		if (EarlySplashSettings.bEnabled)
+		{
+			SetupEarlyStartupSplash(EarlySplashSettings);
+		}
+		else
+		{
+			const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+			SetupLoadingScreen(Settings->StartupLoadingScreen);
+		}
+
+		// Prewarm the texts of the next loading screen while the game is idle, the game viewport gives the scale they're painted at
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FAsyncLoadingScreenModule::OnPostEngineInit);
 	}
 	
 }
@@ -49,7 +156,25 @@ void FAsyncLoadingScreenModule::ShutdownModule()
 	{
 		// TODO: Unregister later
 		GetMoviePlayer()->OnPrepareLoadingScreen().RemoveAll(this);
+		GetMoviePlayer()->OnMoviePlaybackFinished().RemoveAll(this);
 	}
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	// The textures of a loading screen that's still up keep their full mips for whatever runs after
+	FLoadingScreenTextureStreaming::RestoreResidentMips();
+
+	LoadTimeComparison.Reset();
+	CachedLayout.Reset();
+	PreloadHandle.Reset();
+	TextPrewarmer.Reset();
+	LoadTimeModel.Reset();
+	LoadingProgress.Reset();
+	StreamableManager.Reset();
+}
+
+void FAsyncLoadingScreenModule::OnPostEngineInit()
+{
+	TextPrewarmer->Queue(GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen);
 }
 
 bool FAsyncLoadingScreenModule::IsGameModule() const
@@ -57,14 +182,195 @@ bool FAsyncLoadingScreenModule::IsGameModule() const
 	return true;
 }
 
+FStreamableManager& FAsyncLoadingScreenModule::GetStreamableManager()
+{
+	check(StreamableManager.IsValid());
+	return *StreamableManager;
+}
+
+TSharedRef<FLoadingScreenProgress, ESPMode::ThreadSafe> FAsyncLoadingScreenModule::GetLoadingProgress() const
+{
+	check(LoadingProgress.IsValid());
+	return LoadingProgress.ToSharedRef();
+}
+
+TSharedPtr<FStreamableHandle> FAsyncLoadingScreenModule::PreloadLoadingScreenAssets(int32 BackgroundIndex, int32 TipTextIndex, FSimpleDelegate OnComplete)
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_PreloadLoadingScreenAssets);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	const FALoadingScreenSettings& LoadingScreenSettings = GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen;
+
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->ReleaseHandle();
+		PreloadHandle.Reset();
+	}
+
+	// Pick the background and tip now so we know what to load
+	PreloadedBackgroundIndex = INDEX_NONE;
+	PreloadedTipTextIndex = INDEX_NONE;
+	const FBackgroundSettings& Background = LoadingScreenSettings.Background;
+	const FTipSettings& TipWidget = LoadingScreenSettings.TipWidget;
+	const int32 NumBackgrounds = Background.GetNumBackgrounds();
+	if (NumBackgrounds > 0)
+	{
+		PreloadedBackgroundIndex = (BackgroundIndex >= 0 && BackgroundIndex < NumBackgrounds) ? BackgroundIndex : PickBackgroundIndex(NumBackgrounds, Background.bSetDisplayBackgroundManually);
+	}
+	if (TipWidget.TipText.Num() > 0)
+	{
+		PreloadedTipTextIndex = TipWidget.TipText.IsValidIndex(TipTextIndex) ? TipTextIndex : PickTipTextIndex(TipWidget.TipText.Num(), TipWidget.bSetDisplayTipTextManually);
+	}
+
+	TArray<FSoftObjectPath> AssetsToLoad;
+	GatherLoadingScreenAssets(LoadingScreenSettings, PreloadedBackgroundIndex, AssetsToLoad);
+
+	if (AssetsToLoad.Num() > 0)
+	{
+		PreloadHandle = GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate::CreateLambda([this, OnComplete]()
+		{
+			LLM_SCOPE_LOADING_SCREEN();
+
+			// Shaping the texts has the font cache load the face data and rasterize the glyphs while the game is idle
+			TextPrewarmer->Queue(GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen);
+			OnComplete.ExecuteIfBound();
+		}), FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	if (!PreloadHandle.IsValid())
+	{
+		TextPrewarmer->Queue(LoadingScreenSettings);
+		OnComplete.ExecuteIfBound();
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Preloading %d loading screen assets, background %d, tip text %d."), AssetsToLoad.Num(), PreloadedBackgroundIndex, PreloadedTipTextIndex);
+
+	return PreloadHandle;
+}
+
+int32 FAsyncLoadingScreenModule::PickBackgroundIndex(int32 NumImages, bool bSetDisplayBackgroundManually) const
+{
+	if (PreloadedBackgroundIndex >= 0 && PreloadedBackgroundIndex < NumImages)
+	{
+		return PreloadedBackgroundIndex;
+	}
+
+	if (bSetDisplayBackgroundManually == true)
+	{
+		const int32 DisplayBackgroundIndex = UAsyncLoadingScreenLibrary::GetDisplayBackgroundIndex();
+		if (DisplayBackgroundIndex >= 0 && DisplayBackgroundIndex < NumImages)
+		{
+			return DisplayBackgroundIndex;
+		}
+	}
+
+	return FMath::RandRange(0, NumImages - 1);
+}
+
+int32 FAsyncLoadingScreenModule::PickTipTextIndex(int32 NumTipTexts, bool bSetDisplayTipTextManually) const
+{
+	if (PreloadedTipTextIndex >= 0 && PreloadedTipTextIndex < NumTipTexts)
+	{
+		return PreloadedTipTextIndex;
+	}
+
+	if (bSetDisplayTipTextManually == true)
+	{
+		const int32 DisplayTipTextIndex = UAsyncLoadingScreenLibrary::GetDisplayTipTextIndex();
+		if (DisplayTipTextIndex >= 0 && DisplayTipTextIndex < NumTipTexts)
+		{
+			return DisplayTipTextIndex;
+		}
+	}
+
+	return FMath::RandRange(0, NumTipTexts - 1);
+}
+
+void FAsyncLoadingScreenModule::GatherLoadingScreenAssets(const FALoadingScreenSettings& LoadingScreenSettings, int32 BackgroundIndex, TArray<FSoftObjectPath>& OutAssets) const
+{
+	if (!LoadingScreenSettings.bShowWidgetOverlay)
+	{
+		return;
+	}
+
+	// Image files are decoded when the loading screen shows up
+	const FBackgroundSettings& Background = LoadingScreenSettings.Background;
+	for (int32 Index = 0; Index < Background.Images.Num(); Index++)
+	{
+		if ((BackgroundIndex == INDEX_NONE || BackgroundIndex == Index) && !Background.Images[Index].IsNull())
+		{
+			OutAssets.AddUnique(Background.Images[Index]);
+		}
+	}
+
+	const FLoadingWidgetSettings& LoadingWidget = LoadingScreenSettings.LoadingWidget;
+	if (LoadingWidget.LoadingIconType == ELoadingIconType::LIT_ImageSequence)
+	{
+		if (!LoadingWidget.ImageSequenceSettings.Flipbook.IsNull())
+		{
+			OutAssets.AddUnique(LoadingWidget.ImageSequenceSettings.Flipbook.ToSoftObjectPath());
+		}
+		else if (!LoadingWidget.ImageSequenceSettings.DeltaSequence.IsNull())
+		{
+			OutAssets.AddUnique(LoadingWidget.ImageSequenceSettings.DeltaSequence.ToSoftObjectPath());
+		}
+		else if (!LoadingWidget.ImageSequenceSettings.AnimatedImageFile.FilePath.IsEmpty())
+		{
+			// Animated image files are streamed when the loading screen shows up
+		}
+		else
+		{
+			for (const TSoftObjectPtr<UTexture2D>& Image : LoadingWidget.ImageSequenceSettings.Images)
+			{
+				if (!Image.IsNull())
+				{
+					OutAssets.AddUnique(Image.ToSoftObjectPath());
+				}
+			}
+		}
+	}
+
+	// The fonts are hard referenced by the settings so they're already resident, the text prewarmer loads their face data
+}
+
+void FAsyncLoadingScreenModule::GatherSessionAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	const FALoadingScreenSettings* ComparisonSettings = LoadTimeComparison.IsValid() ? LoadTimeComparison->GetLoadingScreenOverride() : nullptr;
+	const FALoadingScreenSettings& LoadingScreenSettings = ComparisonSettings ? *ComparisonSettings : GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen;
+
+	// Until a background is picked ahead of time, any of them may be shown
+	GatherLoadingScreenAssets(LoadingScreenSettings, PreloadedBackgroundIndex, OutAssets);
+}
+
 void FAsyncLoadingScreenModule::PreSetupLoadingScreen()
 {
+	const FALoadingScreenSettings* ComparisonSettings = LoadTimeComparison.IsValid() ? LoadTimeComparison->GetLoadingScreenOverride() : nullptr;
+	if (ComparisonSettings)
+	{
+		if (!ComparisonSettings->bShowWidgetOverlay && ComparisonSettings->MoviePaths.Num() == 0)
+		{
+			// Nothing to show, the movie player skips the loading screen
+			GetMoviePlayer()->SetupLoadingScreen(FLoadingScreenAttributes());
+		}
+		else
+		{
+			SetupLoadingScreen(*ComparisonSettings);
+		}
+		return;
+	}
+
 	const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
 	SetupLoadingScreen(Settings->DefaultLoadingScreen);
 }
 
 void FAsyncLoadingScreenModule::SetupLoadingScreen(const FALoadingScreenSettings& LoadingScreenSettings)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_SetupLoadingScreen);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	// The time to the first frame includes the setup itself
+	LoadingScreenStartTime = FPlatformTime::Seconds();
+
 	TArray<FString> MoviesList = LoadingScreenSettings.MoviePaths;
 
 	// Shuffle the movies list
@@ -98,34 +404,262 @@ void FAsyncLoadingScreenModule::SetupLoadingScreen(const FALoadingScreenSettings
 	LoadingScreen.MoviePaths = MoviesList;
 	LoadingScreen.PlaybackType = LoadingScreenSettings.PlaybackType;
 
+	LoadTimeModel->BeginSession();
+	LoadingScreenMinimumDisplayTime = LoadingScreenSettings.MinimumLoadingScreenDisplayTime;
+	LoadingScreenMaxFrameRate = CVarMaxFrameRate.GetValueOnGameThread() >= 0.0f ? CVarMaxFrameRate.GetValueOnGameThread() : LoadingScreenSettings.MaxFrameRate;
+	LoadingScreenMaxIdleFrameRate = CVarMaxIdleFrameRate.GetValueOnGameThread() >= 0.0f ? CVarMaxIdleFrameRate.GetValueOnGameThread() : LoadingScreenSettings.MaxIdleFrameRate;
+
 	if (LoadingScreenSettings.bShowWidgetOverlay)
 	{
-		const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
-
-		switch (LoadingScreenSettings.Layout)
-		{
-		case EAsyncLoadingScreenLayout::ALSL_Classic:
-			LoadingScreen.WidgetLoadingScreen = SNew(SClassicLayout, LoadingScreenSettings, Settings->Classic);
-			break;
-		case EAsyncLoadingScreenLayout::ALSL_Center:
-			LoadingScreen.WidgetLoadingScreen = SNew(SCenterLayout, LoadingScreenSettings, Settings->Center);
-			break;
-		case EAsyncLoadingScreenLayout::ALSL_Letterbox:
-			LoadingScreen.WidgetLoadingScreen = SNew(SLetterboxLayout, LoadingScreenSettings, Settings->Letterbox);
-			break;
-		case EAsyncLoadingScreenLayout::ALSL_Sidebar:
-			LoadingScreen.WidgetLoadingScreen = SNew(SSidebarLayout, LoadingScreenSettings, Settings->Sidebar);
-			break;
-		case EAsyncLoadingScreenLayout::ALSL_DualSidebar:
-			LoadingScreen.WidgetLoadingScreen = SNew(SDualSidebarLayout, LoadingScreenSettings, Settings->DualSidebar);
-			break;
+		if (LoadingScreenSettings.LoadingWidget.bShowProgressBar)
+		{
+			LoadingProgress->Start();
+			LoadingProgress->SetExpectedMilestones(LoadTimeModel->GetExpectedMilestones(LoadTimeModel->GetSessionMapName()));
 		}
-		
+
+		// Pick the tip now so the tip widget shows the same one, it's reset once the loading screen is finished
+		const FTipSettings& TipWidget = LoadingScreenSettings.TipWidget;
+		if (TipWidget.TipText.Num() > 0 && !TipWidget.TipText.IsValidIndex(PreloadedTipTextIndex))
+		{
+			PreloadedTipTextIndex = PickTipTextIndex(TipWidget.TipText.Num(), TipWidget.bSetDisplayTipTextManually);
+		}
+
+		// Whatever the first frame shows that wasn't prewarmed yet is done now, so it doesn't rasterize glyphs on the loading thread
+		TextPrewarmer->Flush(LoadingScreenSettings, PreloadedTipTextIndex);
+
+		const double ConstructStartTime = FPlatformTime::Seconds();
+		bool bReused = false;
+		TSharedPtr<SLoadingScreenLayout> Layout;
+
+		if (LoadingScreenSettings.bReuseWidgetOverlay)
+		{
+			const uint32 LayoutHash = GetLayoutSettingsHash(LoadingScreenSettings);
+			if (CachedLayout.IsValid() && CachedLayoutHash == LayoutHash)
+			{
+				// Only pick the background and tip again
+				CachedLayout->Rebind();
+				bReused = true;
+			}
+			else
+			{
+				CachedLayout = ConstructLayout(LoadingScreenSettings);
+				CachedLayoutHash = LayoutHash;
+			}
+
+			Layout = CachedLayout;
+		}
+		else
+		{
+			CachedLayout.Reset();
+			Layout = ConstructLayout(LoadingScreenSettings);
+		}
+
+		// Applied every time, the console variables can override the caps of a reused layout
+		Layout->SetMaxFrameRate(LoadingScreenMaxFrameRate, LoadingScreenMaxIdleFrameRate);
+		LoadingScreen.WidgetLoadingScreen = Layout;
+		ActiveLayout = Layout;
+
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Widget overlay %s in %.3f ms."), bReused ? TEXT("reused") : TEXT("constructed"), (FPlatformTime::Seconds() - ConstructStartTime) * 1000.0);
 	}
 	
 	GetMoviePlayer()->SetupLoadingScreen(LoadingScreen);
 }
 
+void FAsyncLoadingScreenModule::SetupEarlyStartupSplash(const FEarlyStartupSplashSettings& SplashSettings)
+{
+	// No UObject can be touched here, everything comes from the config and loose image files
+	FLoadingScreenAttributes LoadingScreen;
+	LoadingScreen.MinimumLoadingScreenDisplayTime = SplashSettings.MinimumDisplayTime;
+	LoadingScreen.bAutoCompleteWhenLoadingCompletes = true;
+	LoadingScreen.bAllowInEarlyStartup = true;
+	LoadingScreen.WidgetLoadingScreen = SNew(SEarlyStartupSplash, SplashSettings);
+
+	GetMoviePlayer()->SetupLoadingScreen(LoadingScreen);
+	bShowingEarlyStartupSplash = true;
+
+	// The module loads in the PreLoadingScreen phase either way, the splash only saves loading the startup loading screen assets
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Early startup splash set up %.2f ms after launch."), (FPlatformTime::Seconds() - GStartTime) * 1000.0);
+}
+
+void FAsyncLoadingScreenModule::OnLoadingScreenFinished()
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_LoadingScreenFinished);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	if (LoadingScreenStartTime > 0.0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loading screen shown for %.3f s, frame rate capped at %.1f fps, %.1f fps when idle (0 is uncapped)."),
+			FPlatformTime::Seconds() - LoadingScreenStartTime, LoadingScreenMaxFrameRate, LoadingScreenMaxIdleFrameRate);
+		RecordLoadingScreenStats();
+		LoadingScreenStartTime = 0.0;
+	}
+	ActiveLayout.Reset();
+
+	LoadTimeModel->EndSession();
+	LoadingProgress->Stop();
+
+	// The settings can be read now without holding up the startup, tell why the startup loading screen didn't show
+	if (bShowingEarlyStartupSplash)
+	{
+		bShowingEarlyStartupSplash = false;
+
+		const FALoadingScreenSettings& StartupLoadingScreen = GetDefault<ULoadingScreenSettings>()->StartupLoadingScreen;
+		if (StartupLoadingScreen.MoviePaths.Num() > 0 || StartupLoadingScreen.bShowWidgetOverlay)
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("The early startup splash was shown instead of the Startup Loading Screen, its movies and widget overlay were skipped. Clear its movies and widget overlay if the splash is all you want at startup."));
+		}
+	}
+
+	// The textures go back to their own LOD bias, the next loading screen limits them again
+	FLoadingScreenTextureStreaming::RestoreResidentMips();
+
+	// Keep the cached widget overlay but let its images be garbage collected until the next loading screen
+	if (CachedLayout.IsValid())
+	{
+		CachedLayout->ReleaseResources();
+	}
+
+	// The preloaded assets were only needed for this loading screen
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->ReleaseHandle();
+		PreloadHandle.Reset();
+	}
+	PreloadedBackgroundIndex = INDEX_NONE;
+	PreloadedTipTextIndex = INDEX_NONE;
+}
+
+void FAsyncLoadingScreenModule::RecordLoadingScreenStats()
+{
+	const double EndTime = FPlatformTime::Seconds();
+
+	FLoadingScreenStats Stats;
+	Stats.bIsValid = true;
+	Stats.MapName = LoadTimeModel->GetSessionMapName();
+	Stats.ShownDuration = static_cast<float>(EndTime - LoadingScreenStartTime);
+
+	// Without a map load, e.g. a manually stopped loading screen, the whole time counts as loading
+	const double PostLoadMapTime = LoadTimeModel->GetSessionPostLoadMapTime();
+	Stats.LoadingDuration = PostLoadMapTime >= LoadingScreenStartTime ? static_cast<float>(PostLoadMapTime - LoadingScreenStartTime) : Stats.ShownDuration;
+	if (LoadingScreenMinimumDisplayTime > 0.0f)
+	{
+		Stats.MinimumDisplayTimeWait = FMath::Clamp(LoadingScreenMinimumDisplayTime - Stats.LoadingDuration, 0.0f, Stats.ShownDuration - Stats.LoadingDuration);
+	}
+
+	if (ActiveLayout.IsValid())
+	{
+		const SLoadingScreenLayout::FFrameStats FrameStats = ActiveLayout->GetFrameStats();
+		Stats.NumFrames = FrameStats.NumFrames;
+		if (FrameStats.NumFrames > 0)
+		{
+			Stats.TimeToFirstPaint = static_cast<float>(FrameStats.FirstPaintTime - LoadingScreenStartTime);
+			Stats.AveragePaintTimeMs = static_cast<float>(FrameStats.AveragePaintTimeMs);
+			Stats.AverageFrameTimeMs = static_cast<float>(FrameStats.AverageFrameTimeMs);
+			Stats.MaxFrameTimeMs = static_cast<float>(FrameStats.MaxFrameTimeMs);
+		}
+	}
+
+	LastLoadingScreenStats = Stats;
+
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loading screen stats: first frame at %.3f s, loading for %.3f s, waited %.3f s for the minimum display time, %d frames, %.3f ms average paint, %.3f ms average frame, %.3f ms longest frame."),
+		Stats.TimeToFirstPaint, Stats.LoadingDuration, Stats.MinimumDisplayTimeWait, Stats.NumFrames, Stats.AveragePaintTimeMs, Stats.AverageFrameTimeMs, Stats.MaxFrameTimeMs);
+
+	// One row per loading screen, the file is kept across runs so sessions can be compared
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AsyncLoadingScreen.csv"));
+	FString Csv;
+	if (!IFileManager::Get().FileExists(*FilePath))
+	{
+		Csv += TEXT("Time,Map,TimeToFirstPaint,ShownDuration,LoadingDuration,MinimumDisplayTimeWait,NumFrames,AveragePaintTimeMs,AverageFrameTimeMs,MaxFrameTimeMs") LINE_TERMINATOR;
+	}
+	Csv += FString::Printf(TEXT("%s,%s,%.3f,%.3f,%.3f,%.3f,%d,%.3f,%.3f,%.3f") LINE_TERMINATOR, *FDateTime::Now().ToString(), *Stats.MapName,
+		Stats.TimeToFirstPaint, Stats.ShownDuration, Stats.LoadingDuration, Stats.MinimumDisplayTimeWait, Stats.NumFrames,
+		Stats.AveragePaintTimeMs, Stats.AverageFrameTimeMs, Stats.MaxFrameTimeMs);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Couldn't write the loading screen stats to %s."), *FilePath);
+	}
+}
+
+TSharedRef<SLoadingScreenLayout> FAsyncLoadingScreenModule::ConstructLayout(const FALoadingScreenSettings& LoadingScreenSettings) const
+{
+	// The widgets only ever see this copy, the settings object may change while the loading thread paints them
+	const FLoadingScreenRenderPlanRef RenderPlan = FLoadingScreenRenderPlan::Create(LoadingScreenSettings, *GetDefault<ULoadingScreenSettings>());
+
+	if (LoadingScreenSettings.bUseLightweightLayout && SLightweightLayout::CanRender(LoadingScreenSettings))
+	{
+		return SNew(SLightweightLayout, RenderPlan);
+	}
+
+	switch (LoadingScreenSettings.Layout)
+	{
+	case EAsyncLoadingScreenLayout::ALSL_Center:
+		return SNew(SCenterLayout, RenderPlan);
+	case EAsyncLoadingScreenLayout::ALSL_Letterbox:
+		return SNew(SLetterboxLayout, RenderPlan);
+	case EAsyncLoadingScreenLayout::ALSL_Sidebar:
+		return SNew(SSidebarLayout, RenderPlan);
+	case EAsyncLoadingScreenLayout::ALSL_DualSidebar:
+		return SNew(SDualSidebarLayout, RenderPlan);
+	case EAsyncLoadingScreenLayout::ALSL_Classic:
+	default:
+		return SNew(SClassicLayout, RenderPlan);
+	}
+}
+
+void FAsyncLoadingScreenModule::StartLoadTimeComparison(const TArray<FString>& MapNames, int32 NumRuns)
+{
+	if (LoadTimeComparison.IsValid() && LoadTimeComparison->IsRunning())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("A load time comparison is already running."));
+		return;
+	}
+
+	LoadTimeComparison = MakeShared<FLoadingScreenLoadTimeComparison>(MapNames, NumRuns);
+	if (!LoadTimeComparison->Start())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Couldn't start the load time comparison, it needs maps and a game world to travel from."));
+		LoadTimeComparison.Reset();
+	}
+}
+
+void FAsyncLoadingScreenModule::StopLoadTimeComparison()
+{
+	if (LoadTimeComparison.IsValid())
+	{
+		LoadTimeComparison->Stop();
+	}
+}
+
+uint32 FAsyncLoadingScreenModule::GetLayoutSettingsHash(const FALoadingScreenSettings& LoadingScreenSettings) const
+{
+	const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+	FString ExportedSettings;
+	FALoadingScreenSettings::StaticStruct()->ExportText(ExportedSettings, &LoadingScreenSettings, nullptr, nullptr, PPF_None, nullptr);
+
+	switch (LoadingScreenSettings.Layout)
+	{
+	case EAsyncLoadingScreenLayout::ALSL_Classic:
+		FClassicLayoutSettings::StaticStruct()->ExportText(ExportedSettings, &Settings->Classic, nullptr, nullptr, PPF_None, nullptr);
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Center:
+		FCenterLayoutSettings::StaticStruct()->ExportText(ExportedSettings, &Settings->Center, nullptr, nullptr, PPF_None, nullptr);
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Letterbox:
+		FLetterboxLayoutSettings::StaticStruct()->ExportText(ExportedSettings, &Settings->Letterbox, nullptr, nullptr, PPF_None, nullptr);
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Sidebar:
+		FSidebarLayoutSettings::StaticStruct()->ExportText(ExportedSettings, &Settings->Sidebar, nullptr, nullptr, PPF_None, nullptr);
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_DualSidebar:
+		FDualSidebarLayoutSettings::StaticStruct()->ExportText(ExportedSettings, &Settings->DualSidebar, nullptr, nullptr, PPF_None, nullptr);
+		break;
+	}
+
+	return FCrc::StrCrc32(*ExportedSettings);
+}
+
 void FAsyncLoadingScreenModule::ShuffleMovies(TArray<FString>& MoviesList)
 {
 	if (MoviesList.Num() > 0)
@@ -8,6 +8,45 @@
 
 
 #include "AsyncLoadingScreenLibrary.h"
+#include "AsyncLoadingScreen.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StreamableManager.h"
+#include "LatentActions.h"
+
+/**
+ * Latent action waiting for the preloaded loading screen assets
+ */
+class FPreloadLoadingScreenAssetsAction : public FPendingLatentAction
+{
+public:
+	FPreloadLoadingScreenAssetsAction(const FLatentActionInfo& LatentInfo, TSharedPtr<FStreamableHandle> InHandle)
+		: ExecutionFunction(LatentInfo.ExecutionFunction)
+		, OutputLink(LatentInfo.Linkage)
+		, CallbackTarget(LatentInfo.CallbackTarget)
+		, Handle(InHandle)
+	{
+	}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		const bool bDone = !Handle.IsValid() || Handle->HasLoadCompleted() || Handle->WasCanceled();
+		Response.FinishAndTriggerIf(bDone, ExecutionFunction, OutputLink, CallbackTarget);
+	}
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Preloading loading screen assets");
+	}
+#endif
+
+private:
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+	TSharedPtr<FStreamableHandle> Handle;
+};
 
 int32 UAsyncLoadingScreenLibrary::DisplayBackgroundIndex = -1;
 int32 UAsyncLoadingScreenLibrary::DisplayTipTextIndex = -1;
@@ -27,3 +66,24 @@ void UAsyncLoadingScreenLibrary::SetDisplayMovieIndex(int32 MovieIndex)
 {
 	UAsyncLoadingScreenLibrary::DisplayMovieIndex = MovieIndex;
 }
+
+void UAsyncLoadingScreenLibrary::PreloadLoadingScreenAssets(UObject* WorldContextObject, FLatentActionInfo LatentInfo, int32 BackgroundIndex, int32 TipTextIndex)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	if (LatentActionManager.FindExistingAction<FPreloadLoadingScreenAssetsAction>(LatentInfo.CallbackTarget, LatentInfo.UUID) == nullptr)
+	{
+		TSharedPtr<FStreamableHandle> Handle = FAsyncLoadingScreenModule::Get().PreloadLoadingScreenAssets(BackgroundIndex, TipTextIndex);
+		LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FPreloadLoadingScreenAssetsAction(LatentInfo, Handle));
+	}
+}
+
+FLoadingScreenStats UAsyncLoadingScreenLibrary::GetLastLoadingScreenStats()
+{
+	return FAsyncLoadingScreenModule::IsAvailable() ? FAsyncLoadingScreenModule::Get().GetLastLoadingScreenStats() : FLoadingScreenStats();
+}
@@ -0,0 +1,773 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenAnimatedImage.h"
+#include "AsyncLoadingScreen.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	// Browsers show frames with a delay under 20 ms for 100 ms, do the same
+	constexpr float MinFrameDuration = 0.02f;
+	constexpr float DefaultFrameDuration = 0.1f;
+
+	// Largest canvas and frame side accepted, a BGRA8 canvas this size still fits the int32 size of a TArray
+	constexpr int32 MaxImageSize = 8192;
+
+	const uint8 PngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	uint16 ReadLittleEndian16(const uint8* Data)
+	{
+		return static_cast<uint16>(Data[0] | (Data[1] << 8));
+	}
+
+	uint16 ReadBigEndian16(const uint8* Data)
+	{
+		return static_cast<uint16>((Data[0] << 8) | Data[1]);
+	}
+
+	uint32 ReadBigEndian32(const uint8* Data)
+	{
+		return (static_cast<uint32>(Data[0]) << 24) | (static_cast<uint32>(Data[1]) << 16) | (static_cast<uint32>(Data[2]) << 8) | Data[3];
+	}
+
+	void WriteBigEndian32(TArray<uint8>& Out, uint32 Value)
+	{
+		Out.Add(static_cast<uint8>(Value >> 24));
+		Out.Add(static_cast<uint8>(Value >> 16));
+		Out.Add(static_cast<uint8>(Value >> 8));
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	/** Clears a rect of the canvas to transparent */
+	void ClearRect(TArray<uint8>& Canvas, const FIntPoint& CanvasSize, const FIntRect& Rect)
+	{
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			FMemory::Memzero(&Canvas[(Y * CanvasSize.X + Rect.Min.X) * 4], Rect.Width() * 4);
+		}
+	}
+
+	/** Whether the canvas or frame size is small enough to be decoded */
+	bool IsValidImageSize(int64 Width, int64 Height)
+	{
+		return Width > 0 && Height > 0 && Width <= MaxImageSize && Height <= MaxImageSize;
+	}
+
+	/** Clamps the frame rect to the canvas, the offsets and size come straight from the file so they're added up in 64 bits */
+	FIntRect ClampRect(int64 X, int64 Y, int64 Width, int64 Height, const FIntPoint& CanvasSize)
+	{
+		return FIntRect(
+			static_cast<int32>(FMath::Clamp<int64>(X, 0, CanvasSize.X)), static_cast<int32>(FMath::Clamp<int64>(Y, 0, CanvasSize.Y)),
+			static_cast<int32>(FMath::Clamp<int64>(X + Width, 0, CanvasSize.X)), static_cast<int32>(FMath::Clamp<int64>(Y + Height, 0, CanvasSize.Y)));
+	}
+
+	/**
+	 * GIF87a/GIF89a decoder. The file is parsed once for the frame table, then each frame's LZW stream is decoded when it's needed.
+	 */
+	class FGifAnimatedImage : public FLoadingScreenAnimatedImage
+	{
+	public:
+		bool Parse(TArray<uint8>&& InFileData)
+		{
+			FileData = MoveTemp(InFileData);
+			const uint8* Data = FileData.GetData();
+			const int32 DataSize = FileData.Num();
+			if (DataSize < 13)
+			{
+				return false;
+			}
+
+			Size = FIntPoint(ReadLittleEndian16(Data + 6), ReadLittleEndian16(Data + 8));
+			const uint8 ScreenFlags = Data[10];
+			int32 Offset = 13;
+
+			if (ScreenFlags & 0x80)
+			{
+				GlobalPaletteOffset = Offset;
+				GlobalPaletteSize = 1 << ((ScreenFlags & 0x07) + 1);
+				Offset += GlobalPaletteSize * 3;
+			}
+
+			FFrame PendingControl;
+			while (Offset < DataSize)
+			{
+				const uint8 BlockType = Data[Offset++];
+				if (BlockType == 0x3B)
+				{
+					// Trailer
+					break;
+				}
+				else if (BlockType == 0x21 && Offset < DataSize)
+				{
+					const uint8 Label = Data[Offset++];
+					if (Label == 0xF9 && Offset + 5 < DataSize && Data[Offset] == 4)
+					{
+						// Graphic control extension
+						const uint8 Flags = Data[Offset + 1];
+						PendingControl.Disposal = (Flags >> 2) & 0x07;
+						PendingControl.TransparentIndex = (Flags & 0x01) ? Data[Offset + 4] : -1;
+						PendingControl.Duration = ReadLittleEndian16(Data + Offset + 2) / 100.0f;
+					}
+
+					if (!SkipSubBlocks(Offset))
+					{
+						break;
+					}
+				}
+				else if (BlockType == 0x2C && Offset + 9 <= DataSize)
+				{
+					// Image descriptor
+					FFrame Frame = PendingControl;
+					PendingControl = FFrame();
+
+					Frame.Rect = ClampRect(ReadLittleEndian16(Data + Offset), ReadLittleEndian16(Data + Offset + 2), ReadLittleEndian16(Data + Offset + 4), ReadLittleEndian16(Data + Offset + 6), Size);
+					Frame.Width = ReadLittleEndian16(Data + Offset + 4);
+					Frame.Height = ReadLittleEndian16(Data + Offset + 6);
+					const uint8 ImageFlags = Data[Offset + 8];
+					Frame.bInterlaced = (ImageFlags & 0x40) != 0;
+					Offset += 9;
+
+					if (ImageFlags & 0x80)
+					{
+						Frame.PaletteOffset = Offset;
+						Frame.PaletteSize = 1 << ((ImageFlags & 0x07) + 1);
+						Offset += Frame.PaletteSize * 3;
+					}
+					else
+					{
+						Frame.PaletteOffset = GlobalPaletteOffset;
+						Frame.PaletteSize = GlobalPaletteSize;
+					}
+
+					if (Offset >= DataSize)
+					{
+						break;
+					}
+
+					Frame.MinCodeSize = Data[Offset++];
+					Frame.DataOffset = Offset;
+					if (!SkipSubBlocks(Offset))
+					{
+						break;
+					}
+
+					if (Frame.PaletteOffset != INDEX_NONE && Frame.MinCodeSize >= 2 && Frame.MinCodeSize <= 11 && IsValidImageSize(Frame.Width, Frame.Height))
+					{
+						Frames.Add(Frame);
+					}
+				}
+				else
+				{
+					break;
+				}
+			}
+
+			if (!IsValidImageSize(Size.X, Size.Y))
+			{
+				return false;
+			}
+
+			Canvas.SetNumZeroed(static_cast<int64>(Size.X) * Size.Y * 4);
+			return Frames.Num() > 0;
+		}
+
+		virtual int32 GetNumFrames() const override
+		{
+			return Frames.Num();
+		}
+
+		virtual bool DecodeNextFrame(TArray<uint8>& OutPixels, float& OutDuration) override
+		{
+			if (NextFrame == 0)
+			{
+				FMemory::Memzero(Canvas.GetData(), Canvas.Num());
+				PreviousDisposal = 0;
+			}
+
+			// Dispose of the previous frame
+			if (PreviousDisposal == 2)
+			{
+				ClearRect(Canvas, Size, PreviousRect);
+			}
+			else if (PreviousDisposal == 3 && PreviousCanvas.Num() == Canvas.Num())
+			{
+				FMemory::Memcpy(Canvas.GetData(), PreviousCanvas.GetData(), Canvas.Num());
+			}
+
+			const FFrame& Frame = Frames[NextFrame];
+			if (Frame.Disposal == 3)
+			{
+				PreviousCanvas = Canvas;
+			}
+
+			const bool bDecoded = DecodeFrame(Frame);
+
+			PreviousDisposal = Frame.Disposal;
+			PreviousRect = Frame.Rect;
+			NextFrame = (NextFrame + 1) % Frames.Num();
+
+			OutPixels = Canvas;
+			OutDuration = Frame.Duration < MinFrameDuration ? DefaultFrameDuration : Frame.Duration;
+			return bDecoded;
+		}
+
+	private:
+		struct FFrame
+		{
+			FIntRect Rect;
+			int32 Width = 0;
+			int32 Height = 0;
+			bool bInterlaced = false;
+			int32 PaletteOffset = INDEX_NONE;
+			int32 PaletteSize = 0;
+			int32 MinCodeSize = 0;
+			int32 DataOffset = 0;
+			int32 TransparentIndex = -1;
+			uint8 Disposal = 0;
+			float Duration = 0.0f;
+		};
+
+		/** Skips data sub-blocks up to and including the block terminator */
+		bool SkipSubBlocks(int32& Offset) const
+		{
+			while (Offset < FileData.Num())
+			{
+				const uint8 BlockSize = FileData[Offset++];
+				if (BlockSize == 0)
+				{
+					return true;
+				}
+				Offset += BlockSize;
+			}
+			return false;
+		}
+
+		/** Decodes the LZW stream of the frame and draws its pixels on the canvas */
+		bool DecodeFrame(const FFrame& Frame)
+		{
+			// Gather the sub-blocks into a single stream
+			CodeStream.Reset();
+			int32 Offset = Frame.DataOffset;
+			while (Offset < FileData.Num() && FileData[Offset] != 0)
+			{
+				const int32 BlockSize = FMath::Min<int32>(FileData[Offset], FileData.Num() - Offset - 1);
+				CodeStream.Append(&FileData[Offset + 1], BlockSize);
+				Offset += BlockSize + 1;
+			}
+
+			const int32 NumPixels = Frame.Width * Frame.Height;
+			Indices.SetNumZeroed(NumPixels, false);
+
+			const int32 ClearCode = 1 << Frame.MinCodeSize;
+			const int32 EndCode = ClearCode + 1;
+			int32 CodeSize = Frame.MinCodeSize + 1;
+			int32 NextCode = EndCode + 1;
+			int32 PreviousCode = -1;
+			uint8 FirstChar = 0;
+
+			for (int32 Code = 0; Code < ClearCode; ++Code)
+			{
+				Prefix[Code] = 0;
+				Suffix[Code] = static_cast<uint8>(Code);
+			}
+
+			int64 BitOffset = 0;
+			const int64 NumBits = static_cast<int64>(CodeStream.Num()) * 8;
+			int32 PixelIndex = 0;
+
+			while (PixelIndex < NumPixels && BitOffset + CodeSize <= NumBits)
+			{
+				// Codes are packed least significant bit first
+				int32 Code = 0;
+				for (int32 Bit = 0; Bit < CodeSize; ++Bit, ++BitOffset)
+				{
+					Code |= ((CodeStream[BitOffset >> 3] >> (BitOffset & 7)) & 1) << Bit;
+				}
+
+				if (Code == ClearCode)
+				{
+					CodeSize = Frame.MinCodeSize + 1;
+					NextCode = EndCode + 1;
+					PreviousCode = -1;
+					continue;
+				}
+				else if (Code == EndCode)
+				{
+					break;
+				}
+				else if (PreviousCode == -1)
+				{
+					if (Code >= ClearCode)
+					{
+						return false;
+					}
+					Indices[PixelIndex++] = static_cast<uint8>(Code);
+					FirstChar = static_cast<uint8>(Code);
+					PreviousCode = Code;
+					continue;
+				}
+
+				const int32 InCode = Code;
+				int32 StackSize = 0;
+				if (Code >= NextCode)
+				{
+					// The code being defined: previous string plus its own first character
+					if (Code > NextCode)
+					{
+						return false;
+					}
+					Stack[StackSize++] = FirstChar;
+					Code = PreviousCode;
+				}
+
+				while (Code >= ClearCode)
+				{
+					Stack[StackSize++] = Suffix[Code];
+					Code = Prefix[Code];
+				}
+				FirstChar = Suffix[Code];
+				Stack[StackSize++] = FirstChar;
+
+				while (StackSize > 0 && PixelIndex < NumPixels)
+				{
+					Indices[PixelIndex++] = Stack[--StackSize];
+				}
+
+				if (NextCode < MaxCodes)
+				{
+					Prefix[NextCode] = static_cast<uint16>(PreviousCode);
+					Suffix[NextCode] = FirstChar;
+					NextCode++;
+					if (NextCode == (1 << CodeSize) && CodeSize < 12)
+					{
+						CodeSize++;
+					}
+				}
+
+				PreviousCode = InCode;
+			}
+
+			// Draw the indices on the canvas, interlaced frames store every 8th row first, then every 4th and every 2nd
+			const uint8* Palette = &FileData[Frame.PaletteOffset];
+			int32 SourceRow = 0;
+			static const int32 PassStart[] = { 0, 4, 2, 1 };
+			static const int32 PassStep[] = { 8, 8, 4, 2 };
+			const int32 NumPasses = Frame.bInterlaced ? 4 : 1;
+
+			for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+			{
+				const int32 Start = Frame.bInterlaced ? PassStart[Pass] : 0;
+				const int32 Step = Frame.bInterlaced ? PassStep[Pass] : 1;
+				for (int32 Row = Start; Row < Frame.Height; Row += Step, ++SourceRow)
+				{
+					const int32 CanvasY = Frame.Rect.Min.Y + Row;
+					if (CanvasY >= Frame.Rect.Max.Y)
+					{
+						continue;
+					}
+
+					const uint8* RowIndices = &Indices[SourceRow * Frame.Width];
+					for (int32 X = 0; X < Frame.Rect.Width(); ++X)
+					{
+						const int32 Index = RowIndices[X];
+						if (Index == Frame.TransparentIndex || Index >= Frame.PaletteSize)
+						{
+							continue;
+						}
+
+						uint8* Pixel = &Canvas[(CanvasY * Size.X + Frame.Rect.Min.X + X) * 4];
+						Pixel[0] = Palette[Index * 3 + 2];
+						Pixel[1] = Palette[Index * 3 + 1];
+						Pixel[2] = Palette[Index * 3 + 0];
+						Pixel[3] = 255;
+					}
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		static constexpr int32 MaxCodes = 4096;
+
+		TArray<FFrame> Frames;
+		int32 GlobalPaletteOffset = INDEX_NONE;
+		int32 GlobalPaletteSize = 0;
+		uint8 PreviousDisposal = 0;
+		FIntRect PreviousRect;
+
+		// LZW decoding state, kept around so it isn't allocated for every frame
+		TArray<uint8> CodeStream;
+		TArray<uint8> Indices;
+		uint16 Prefix[MaxCodes];
+		uint8 Suffix[MaxCodes];
+		uint8 Stack[MaxCodes + 1];
+	};
+
+	/**
+	 * Animated PNG decoder. Each frame is rebuilt as a standalone PNG from the shared header chunks and its fdAT chunks,
+	 * decoded by the engine's PNG wrapper and composited on the canvas.
+	 */
+	class FApngAnimatedImage : public FLoadingScreenAnimatedImage
+	{
+	public:
+		explicit FApngAnimatedImage(IImageWrapperModule& InImageWrapperModule)
+			: ImageWrapperModule(InImageWrapperModule)
+		{
+		}
+
+		bool Parse(TArray<uint8>&& InFileData)
+		{
+			FileData = MoveTemp(InFileData);
+			const uint8* Data = FileData.GetData();
+			const int32 DataSize = FileData.Num();
+			if (DataSize < 8 + 25 || FMemory::Memcmp(Data, PngSignature, sizeof(PngSignature)) != 0)
+			{
+				return false;
+			}
+
+			bool bHasAnimationControl = false;
+			bool bSeenImageData = false;
+			FFrame* CurrentFrame = nullptr;
+			int32 Offset = 8;
+
+			while (Offset + 12 <= DataSize)
+			{
+				const uint32 Length = ReadBigEndian32(Data + Offset);
+				const uint32 Type = ReadBigEndian32(Data + Offset + 4);
+				const int32 ChunkData = Offset + 8;
+				if (Length > static_cast<uint32>(DataSize - ChunkData - 4))
+				{
+					break;
+				}
+
+				if (Type == ChunkType("IHDR") && Length == 13)
+				{
+					// Reject sizes over MaxImageSize before they can wrap around in the int32 point
+					const uint32 Width = ReadBigEndian32(Data + ChunkData);
+					const uint32 Height = ReadBigEndian32(Data + ChunkData + 4);
+					if (!IsValidImageSize(Width, Height))
+					{
+						return false;
+					}
+					Size = FIntPoint(Width, Height);
+					HeaderOffset = ChunkData;
+				}
+				else if (Type == ChunkType("acTL"))
+				{
+					bHasAnimationControl = true;
+				}
+				else if (Type == ChunkType("fcTL") && Length >= 26)
+				{
+					const uint32 Width = ReadBigEndian32(Data + ChunkData + 4);
+					const uint32 Height = ReadBigEndian32(Data + ChunkData + 8);
+					FFrame& Frame = Frames.AddDefaulted_GetRef();
+					if (IsValidImageSize(Width, Height))
+					{
+						Frame.Width = Width;
+						Frame.Height = Height;
+					}
+					Frame.Rect = ClampRect(ReadBigEndian32(Data + ChunkData + 12), ReadBigEndian32(Data + ChunkData + 16), Frame.Width, Frame.Height, Size);
+					const uint16 DelayNumerator = ReadBigEndian16(Data + ChunkData + 20);
+					const uint16 DelayDenominator = ReadBigEndian16(Data + ChunkData + 22);
+					Frame.Duration = static_cast<float>(DelayNumerator) / (DelayDenominator == 0 ? 100.0f : DelayDenominator);
+					Frame.DisposeOp = Data[ChunkData + 24];
+					Frame.BlendOp = Data[ChunkData + 25];
+					CurrentFrame = &Frame;
+				}
+				else if (Type == ChunkType("IDAT"))
+				{
+					bSeenImageData = true;
+
+					// The default image is only part of the animation if a frame control chunk came before it
+					if (CurrentFrame)
+					{
+						CurrentFrame->DataChunks.Add(FIntPoint(ChunkData, Length));
+					}
+					else if (!bHasAnimationControl)
+					{
+						DefaultImageChunks.Add(FIntPoint(ChunkData, Length));
+					}
+				}
+				else if (Type == ChunkType("fdAT") && Length > 4)
+				{
+					if (CurrentFrame)
+					{
+						// Skip the sequence number, the rest is the same as an IDAT chunk
+						CurrentFrame->DataChunks.Add(FIntPoint(ChunkData + 4, Length - 4));
+					}
+				}
+				else if (Type == ChunkType("IEND"))
+				{
+					break;
+				}
+				else if (!bSeenImageData && Type != ChunkType("IHDR"))
+				{
+					// Palette, transparency, gamma... are shared by all frames
+					SharedChunks.Add(FIntPoint(Offset, Length + 12));
+				}
+
+				Offset = ChunkData + Length + 4;
+			}
+
+			// A plain PNG is a single frame animation
+			if (Frames.Num() == 0 && DefaultImageChunks.Num() > 0)
+			{
+				FFrame& Frame = Frames.AddDefaulted_GetRef();
+				Frame.Width = Size.X;
+				Frame.Height = Size.Y;
+				Frame.Rect = FIntRect(FIntPoint::ZeroValue, Size);
+				Frame.Duration = 1.0f;
+				Frame.DataChunks = DefaultImageChunks;
+			}
+
+			Frames.RemoveAll([](const FFrame& Frame) { return Frame.DataChunks.Num() == 0 || Frame.Width <= 0 || Frame.Height <= 0; });
+
+			if (HeaderOffset == INDEX_NONE || !IsValidImageSize(Size.X, Size.Y))
+			{
+				return false;
+			}
+
+			Canvas.SetNumZeroed(static_cast<int64>(Size.X) * Size.Y * 4);
+			return Frames.Num() > 0;
+		}
+
+		virtual int32 GetNumFrames() const override
+		{
+			return Frames.Num();
+		}
+
+		virtual bool DecodeNextFrame(TArray<uint8>& OutPixels, float& OutDuration) override
+		{
+			if (NextFrame == 0)
+			{
+				FMemory::Memzero(Canvas.GetData(), Canvas.Num());
+				PreviousDisposeOp = 0;
+			}
+
+			// Dispose of the previous frame
+			if (PreviousDisposeOp == 1)
+			{
+				ClearRect(Canvas, Size, PreviousRect);
+			}
+			else if (PreviousDisposeOp == 2 && PreviousCanvas.Num() == Canvas.Num())
+			{
+				FMemory::Memcpy(Canvas.GetData(), PreviousCanvas.GetData(), Canvas.Num());
+			}
+
+			const FFrame& Frame = Frames[NextFrame];
+			if (Frame.DisposeOp == 2)
+			{
+				PreviousCanvas = Canvas;
+			}
+
+			const bool bDecoded = DecodeFrame(Frame);
+
+			PreviousDisposeOp = Frame.DisposeOp;
+			PreviousRect = Frame.Rect;
+			NextFrame = (NextFrame + 1) % Frames.Num();
+
+			OutPixels = Canvas;
+			OutDuration = Frame.Duration < MinFrameDuration ? DefaultFrameDuration : Frame.Duration;
+			return bDecoded;
+		}
+
+	private:
+		struct FFrame
+		{
+			FIntRect Rect;
+			int32 Width = 0;
+			int32 Height = 0;
+			float Duration = 0.0f;
+			uint8 DisposeOp = 0;
+			uint8 BlendOp = 0;
+			// Offset and size of the image data in each of the frame's chunks
+			TArray<FIntPoint> DataChunks;
+		};
+
+		static uint32 ChunkType(const char* Name)
+		{
+			return ReadBigEndian32(reinterpret_cast<const uint8*>(Name));
+		}
+
+		void AppendChunk(TArray<uint8>& Out, const char* Type, const uint8* Data, int32 Length) const
+		{
+			WriteBigEndian32(Out, Length);
+			const int32 TypeOffset = Out.Num();
+			Out.Append(reinterpret_cast<const uint8*>(Type), 4);
+			if (Length > 0)
+			{
+				Out.Append(Data, Length);
+			}
+			WriteBigEndian32(Out, FCrc::MemCrc32(&Out[TypeOffset], Length + 4));
+		}
+
+		/** Rebuilds the frame as a standalone PNG, decodes it and composites it on the canvas */
+		bool DecodeFrame(const FFrame& Frame)
+		{
+			FramePng.Reset();
+			FramePng.Append(PngSignature, sizeof(PngSignature));
+
+			uint8 Header[13];
+			FMemory::Memcpy(Header, &FileData[HeaderOffset], sizeof(Header));
+			for (int32 Byte = 0; Byte < 4; ++Byte)
+			{
+				Header[Byte] = static_cast<uint8>(Frame.Width >> (24 - Byte * 8));
+				Header[4 + Byte] = static_cast<uint8>(Frame.Height >> (24 - Byte * 8));
+			}
+			AppendChunk(FramePng, "IHDR", Header, sizeof(Header));
+
+			for (const FIntPoint& Chunk : SharedChunks)
+			{
+				FramePng.Append(&FileData[Chunk.X], Chunk.Y);
+			}
+
+			for (const FIntPoint& Chunk : Frame.DataChunks)
+			{
+				AppendChunk(FramePng, "IDAT", &FileData[Chunk.X], Chunk.Y);
+			}
+
+			AppendChunk(FramePng, "IEND", nullptr, 0);
+
+			TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+			const TArray<uint8>* RawData = nullptr;
+			if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(FramePng.GetData(), FramePng.Num()) || !ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData) || RawData == nullptr
+				|| RawData->Num() != Frame.Width * Frame.Height * 4)
+			{
+				return false;
+			}
+
+			const uint8* FramePixels = RawData->GetData();
+			for (int32 Y = 0; Y < Frame.Rect.Height(); ++Y)
+			{
+				const uint8* Source = FramePixels + Y * Frame.Width * 4;
+				uint8* Dest = &Canvas[((Frame.Rect.Min.Y + Y) * Size.X + Frame.Rect.Min.X) * 4];
+
+				if (Frame.BlendOp == 0)
+				{
+					FMemory::Memcpy(Dest, Source, Frame.Rect.Width() * 4);
+					continue;
+				}
+
+				// Blend over the canvas
+				for (int32 X = 0; X < Frame.Rect.Width(); ++X, Source += 4, Dest += 4)
+				{
+					const int32 SourceAlpha = Source[3];
+					if (SourceAlpha == 255)
+					{
+						FMemory::Memcpy(Dest, Source, 4);
+					}
+					else if (SourceAlpha > 0)
+					{
+						const int32 DestAlpha = Dest[3] * (255 - SourceAlpha) / 255;
+						const int32 OutAlpha = SourceAlpha + DestAlpha;
+						for (int32 Channel = 0; Channel < 3; ++Channel)
+						{
+							Dest[Channel] = static_cast<uint8>((Source[Channel] * SourceAlpha + Dest[Channel] * DestAlpha) / OutAlpha);
+						}
+						Dest[3] = static_cast<uint8>(OutAlpha);
+					}
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		IImageWrapperModule& ImageWrapperModule;
+		TArray<FFrame> Frames;
+		int32 HeaderOffset = INDEX_NONE;
+		// Offset and size of the whole chunks shared by all frames, and of the default image data
+		TArray<FIntPoint> SharedChunks;
+		TArray<FIntPoint> DefaultImageChunks;
+		uint8 PreviousDisposeOp = 0;
+		FIntRect PreviousRect;
+		// Standalone PNG of the frame being decoded
+		TArray<uint8> FramePng;
+	};
+}
+
+bool FLoadingScreenAnimatedImage::ReadImageSize(const FString& FilePath, FIntPoint& OutSize)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	uint8 Header[24] = {};
+	const int32 HeaderSize = FMath::Min<int64>(sizeof(Header), Reader->TotalSize());
+	Reader->Serialize(Header, HeaderSize);
+
+	int64 Width = 0;
+	int64 Height = 0;
+	if (HeaderSize >= 10 && FMemory::Memcmp(Header, "GIF8", 4) == 0)
+	{
+		Width = ReadLittleEndian16(Header + 6);
+		Height = ReadLittleEndian16(Header + 8);
+	}
+	else if (HeaderSize >= 24 && FMemory::Memcmp(Header, PngSignature, sizeof(PngSignature)) == 0)
+	{
+		// IHDR is always the first chunk
+		Width = ReadBigEndian32(Header + 16);
+		Height = ReadBigEndian32(Header + 20);
+	}
+	else if (HeaderSize >= 12 && FMemory::Memcmp(Header, "RIFF", 4) == 0 && FMemory::Memcmp(Header + 8, "WEBP", 4) == 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("%s is a WebP file, only GIF and PNG/APNG animated images are supported."), *FilePath);
+		return false;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (!IsValidImageSize(Width, Height))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("%s is %lldx%lld, animated images can't be larger than %dx%d."), *FilePath, Width, Height, MaxImageSize, MaxImageSize);
+		return false;
+	}
+
+	OutSize = FIntPoint(static_cast<int32>(Width), static_cast<int32>(Height));
+	return true;
+}
+
+TUniquePtr<FLoadingScreenAnimatedImage> FLoadingScreenAnimatedImage::Open(IImageWrapperModule& ImageWrapperModule, const FString& FilePath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to read animated image file %s."), *FilePath);
+		return nullptr;
+	}
+
+	if (FileData.Num() >= 6 && FMemory::Memcmp(FileData.GetData(), "GIF8", 4) == 0)
+	{
+		TUniquePtr<FGifAnimatedImage> Image = MakeUnique<FGifAnimatedImage>();
+		if (Image->Parse(MoveTemp(FileData)))
+		{
+			return Image;
+		}
+	}
+	else if (FileData.Num() >= 8 && FMemory::Memcmp(FileData.GetData(), PngSignature, sizeof(PngSignature)) == 0)
+	{
+		TUniquePtr<FApngAnimatedImage> Image = MakeUnique<FApngAnimatedImage>(ImageWrapperModule);
+		if (Image->Parse(MoveTemp(FileData)))
+		{
+			return Image;
+		}
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("%s is not a valid GIF or PNG/APNG file."), *FilePath);
+	return nullptr;
+}
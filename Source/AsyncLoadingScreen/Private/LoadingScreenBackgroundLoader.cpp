@@ -0,0 +1,309 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenBackgroundLoader.h"
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenSettings.h"
+#include "Slate/DeferredCleanupSlateBrush.h"
+#include "Brushes/SlateDynamicImageBrush.h"
+#include "Engine/Texture2D.h"
+#include "Engine/StreamableManager.h"
+#include "IImageWrapperModule.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Paths.h"
+#include "Misc/CoreDelegates.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Background Load Time (ms)"), STAT_BackgroundLoadTime, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Background Request"), STAT_BackgroundRequest, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Background Update"), STAT_BackgroundUpdate, STATGROUP_AsyncLoadingScreen);
+
+FLoadingScreenBackgroundLoader::FLoadingScreenBackgroundLoader(const FBackgroundSettings& Settings, const FLoadingScreenTextureLimits& InTextureLimits)
+	: Images(Settings.Images)
+	, bSetDisplayBackgroundManually(Settings.bSetDisplayBackgroundManually)
+	, ImageStretch(Settings.ImageStretch)
+	, ImagePadding(Settings.Padding)
+	, TextureLimits(InTextureLimits)
+{
+	for (const FFilePath& ImageFile : Settings.ImageFiles)
+	{
+		ImageFiles.Add(FPaths::IsRelative(ImageFile.FilePath) ? FPaths::Combine(FPaths::ProjectDir(), ImageFile.FilePath) : ImageFile.FilePath);
+	}
+}
+
+FLoadingScreenBackgroundLoader::~FLoadingScreenBackgroundLoader()
+{
+	Release();
+}
+
+void FLoadingScreenBackgroundLoader::Request()
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_BackgroundRequest);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	const int32 ImageIndex = FAsyncLoadingScreenModule::Get().PickBackgroundIndex(GetNumImages(), bSetDisplayBackgroundManually);
+	RequestTime = FPlatformTime::Seconds();
+
+	if (!Images.IsValidIndex(ImageIndex))
+	{
+		RequestImageFile(ImageFiles[ImageIndex - Images.Num()]);
+		return;
+	}
+
+	const FSoftObjectPath& ImageAsset = Images[ImageIndex];
+	bImageRequestDone = false;
+
+	// Don't go through the streamable manager if the texture is already resident
+	if (UTexture2D* LoadingImage = Cast<UTexture2D>(ImageAsset.ResolveObject()))
+	{
+		SetPendingImage(LoadingImage);
+	}
+	else if (ImageAsset.IsNull())
+	{
+		bImageRequestDone = true;
+	}
+	else
+	{
+		ImageHandle = FAsyncLoadingScreenModule::Get().GetStreamableManager().RequestAsyncLoad(ImageAsset,
+			FStreamableDelegate::CreateSP(this, &FLoadingScreenBackgroundLoader::OnImageLoaded), FStreamableManager::AsyncLoadHighPriority);
+
+		bImageRequestDone = !ImageHandle.IsValid();
+
+		// The streamable delegate is only called on the next game tick, which doesn't come before a blocking LoadMap is done.
+		// Poll the handle while the game thread flushes async loading as well, so the background shows up during the load
+		if (!bImageRequestDone && !FlushUpdateHandle.IsValid())
+		{
+			FlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddSP(this, &FLoadingScreenBackgroundLoader::OnAsyncLoadingFlushUpdate);
+		}
+	}
+}
+
+void FLoadingScreenBackgroundLoader::Release()
+{
+	StopPolling();
+
+	if (ImageHandle.IsValid())
+	{
+		ImageHandle->CancelHandle();
+		ImageHandle.Reset();
+	}
+
+	if (FileDecodeState.IsValid())
+	{
+		FileDecodeState->bCanceled = true;
+		FileDecodeState.Reset();
+	}
+
+	FScopeLock Lock(&PendingImageBrushCS);
+	PendingImageBrush.Reset();
+	bImageRequestDone = true;
+	ImageBrush.Reset();
+	FileImageBrush.Reset();
+	UpdateBrushCounter();
+}
+
+void FLoadingScreenBackgroundLoader::RequestImageFile(const FString& FilePath)
+{
+	FileDecodeState = MakeShared<FFileDecodeState, ESPMode::ThreadSafe>();
+	FileDecodeState->FilePath = FilePath;
+
+	// Work out the area on the game thread, the image size is only known once it's decoded
+	const EStretch::Type Stretch = ImageStretch;
+	const FVector2D AreaSize = FLoadingScreenTextureStreaming::GetViewportSize() - ImagePadding.GetDesiredSize();
+	const bool bDownscale = TextureLimits.bLimitToScreenSize;
+
+	// The module has to be loaded on the game thread, the decoding itself is thread safe
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	TSharedPtr<FFileDecodeState, ESPMode::ThreadSafe> State = FileDecodeState;
+	Async(EAsyncExecution::ThreadPool, [State, Stretch, AreaSize, bDownscale, &ImageWrapperModule]()
+	{
+		LLM_SCOPE_LOADING_SCREEN();
+
+		FLoadingScreenDecodedImage DecodedImage;
+		if (!State->bCanceled && FLoadingScreenImageDecoder::DecodeImageFile(ImageWrapperModule, State->FilePath, DecodedImage))
+		{
+			const float Scale = bDownscale ? FLoadingScreenTextureStreaming::GetStretchScale(Stretch, FVector2D(DecodedImage.Size), AreaSize) : 1.0f;
+			const FIntPoint TargetSize = FLoadingScreenImageDecoder::GetDownscaledSize(DecodedImage.Size, Scale);
+			if (!State->bCanceled && TargetSize != DecodedImage.Size)
+			{
+				FLoadingScreenImageDecoder::Downscale(DecodedImage, TargetSize, State->Image);
+			}
+			else
+			{
+				State->Image = MoveTemp(DecodedImage);
+			}
+		}
+
+		// The brush resource can only be created on the game thread, which polls for the decoded pixels
+		State->bDecoded = true;
+	});
+
+	// Queued game thread tasks wait for the next tick just like the streamable delegates, so poll from the ticker
+	// and from the flush update, the latter is all that runs on the game thread while it's blocked in LoadMap
+	PolledFileDecodeState = FileDecodeState;
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FLoadingScreenBackgroundLoader::Tick));
+	if (!FlushUpdateHandle.IsValid())
+	{
+		FlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddSP(this, &FLoadingScreenBackgroundLoader::OnAsyncLoadingFlushUpdate);
+	}
+}
+
+bool FLoadingScreenBackgroundLoader::Tick(float DeltaTime)
+{
+	CreateFileImageBrush();
+	return true;
+}
+
+void FLoadingScreenBackgroundLoader::CreateFileImageBrush()
+{
+	TSharedPtr<FFileDecodeState, ESPMode::ThreadSafe> State = PolledFileDecodeState;
+	if (!State.IsValid() || !State->bDecoded)
+	{
+		return;
+	}
+
+	LLM_SCOPE_LOADING_SCREEN();
+	StopPolling();
+
+	if (!State->bCanceled && State->Image.IsValid())
+	{
+		const FName TextureName(*FString::Printf(TEXT("LoadingScreenBackground_%s"), *FPaths::GetBaseFilename(State->FilePath)));
+		State->Brush = FSlateDynamicImageBrush::CreateWithImageData(TextureName, FVector2D(State->Image.Size), State->Image.Pixels);
+	}
+
+	// The pixels have been copied into the brush resource, the next update swaps it in
+	State->Image = FLoadingScreenDecodedImage();
+	State->bDone = true;
+}
+
+void FLoadingScreenBackgroundLoader::OnAsyncLoadingFlushUpdate()
+{
+	if (ImageHandle.IsValid() && ImageHandle->HasLoadCompleted())
+	{
+		OnImageLoaded();
+	}
+
+	CreateFileImageBrush();
+}
+
+void FLoadingScreenBackgroundLoader::StopPolling()
+{
+	if (FlushUpdateHandle.IsValid())
+	{
+		FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(FlushUpdateHandle);
+		FlushUpdateHandle.Reset();
+	}
+
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	PolledFileDecodeState.Reset();
+}
+
+void FLoadingScreenBackgroundLoader::OnImageLoaded()
+{
+	// Called by whichever of the flush update and the streamable delegate comes first
+	if (ImageHandle.IsValid() && !bImageRequestDone)
+	{
+		StopPolling();
+
+		if (UTexture2D* LoadingImage = Cast<UTexture2D>(ImageHandle->GetLoadedAsset()))
+		{
+			SetPendingImage(LoadingImage);
+		}
+		else
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to load background image."));
+
+			FScopeLock Lock(&PendingImageBrushCS);
+			bImageRequestDone = true;
+		}
+	}
+}
+
+void FLoadingScreenBackgroundLoader::SetPendingImage(UTexture2D* LoadingImage)
+{
+	const float LoadTimeMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+	SET_FLOAT_STAT(STAT_BackgroundLoadTime, LoadTimeMs);
+	UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("Background image %s arrived after %.2f ms."), *LoadingImage->GetName(), LoadTimeMs);
+
+	// Only keep the mips that are visible in the current viewport
+	const FVector2D AreaSize = FLoadingScreenTextureStreaming::GetViewportSize() - ImagePadding.GetDesiredSize();
+	const FVector2D ImageSize(LoadingImage->GetSurfaceWidth(), LoadingImage->GetSurfaceHeight());
+	FLoadingScreenTextureStreaming::UpdateResidentMips(LoadingImage, FLoadingScreenTextureStreaming::GetStretchScale(ImageStretch, ImageSize, AreaSize), TextureLimits);
+
+	FScopeLock Lock(&PendingImageBrushCS);
+	PendingImageBrush = FDeferredCleanupSlateBrush::CreateBrush(LoadingImage);
+	bImageRequestDone = true;
+	UpdateBrushCounter();
+}
+
+bool FLoadingScreenBackgroundLoader::Update()
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_BackgroundUpdate);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	if (FileDecodeState.IsValid())
+	{
+		if (!FileDecodeState->bDone)
+		{
+			return false;
+		}
+
+		// Move the brush out so only this thread touches its reference count
+		TSharedPtr<FSlateDynamicImageBrush> DecodedBrush = MoveTemp(FileDecodeState->Brush);
+		const bool bHasDecodedBrush = DecodedBrush.IsValid();
+		if (bHasDecodedBrush)
+		{
+			const float LoadTimeMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+			SET_FLOAT_STAT(STAT_BackgroundLoadTime, LoadTimeMs);
+			UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("Background image file %s (%.0fx%.0f) decoded after %.2f ms."), *FPaths::GetCleanFilename(FileDecodeState->FilePath), DecodedBrush->ImageSize.X, DecodedBrush->ImageSize.Y, LoadTimeMs);
+
+			FileImageBrush = DecodedBrush;
+			ImageBrush.Reset();
+			UpdateBrushCounter();
+			INC_DWORD_STAT(STAT_BrushSwaps);
+		}
+
+		FileDecodeState.Reset();
+		return bHasDecodedBrush;
+	}
+
+	FScopeLock Lock(&PendingImageBrushCS);
+	if (PendingImageBrush.IsValid())
+	{
+		ImageBrush = PendingImageBrush;
+		PendingImageBrush.Reset();
+		FileImageBrush.Reset();
+		UpdateBrushCounter();
+		INC_DWORD_STAT(STAT_BrushSwaps);
+		return true;
+	}
+
+	return false;
+}
+
+bool FLoadingScreenBackgroundLoader::IsRequestDone() const
+{
+	FScopeLock Lock(&PendingImageBrushCS);
+	return bImageRequestDone && !PendingImageBrush.IsValid() && !FileDecodeState.IsValid();
+}
+
+const FSlateBrush* FLoadingScreenBackgroundLoader::GetBrush() const
+{
+	return ImageBrush.IsValid() ? ImageBrush->GetSlateBrush() : FileImageBrush.Get();
+}
+
+void FLoadingScreenBackgroundLoader::UpdateBrushCounter()
+{
+	BrushCounter.Set((ImageBrush.IsValid() ? 1 : 0) + (FileImageBrush.IsValid() ? 1 : 0) + (PendingImageBrush.IsValid() ? 1 : 0));
+}
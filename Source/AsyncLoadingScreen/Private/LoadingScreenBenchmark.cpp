@@ -0,0 +1,282 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenSettings.h"
+#include "SLoadingScreenLayout.h"
+#include "SLightweightLayout.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+#include "Input/HittestGrid.h"
+#include "Rendering/DrawElements.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TAutoConsoleVariable<FString> CVarBenchmarkResolutions(
+	TEXT("AsyncLoadingScreen.Benchmark.Resolutions"),
+	TEXT("1280x720,1920x1080,3840x2160"),
+	TEXT("Comma separated resolutions the benchmark paints every layout at."));
+
+static TAutoConsoleVariable<int32> CVarBenchmarkIterations(
+	TEXT("AsyncLoadingScreen.Benchmark.Iterations"),
+	20,
+	TEXT("How many times the benchmark constructs and paints each configuration."));
+
+static TAutoConsoleVariable<float> CVarBenchmarkConstructBudget(
+	TEXT("AsyncLoadingScreen.Benchmark.ConstructBudgetMs"),
+	0.0f,
+	TEXT("Average construct time a configuration may take, in milliseconds. Zero disables the budget."));
+
+static TAutoConsoleVariable<float> CVarBenchmarkPaintBudget(
+	TEXT("AsyncLoadingScreen.Benchmark.PaintBudgetMs"),
+	0.0f,
+	TEXT("Average prepass and paint time a configuration may take at any resolution, in milliseconds. Zero disables the budget."));
+
+static TAutoConsoleVariable<int32> CVarBenchmarkDrawElementBudget(
+	TEXT("AsyncLoadingScreen.Benchmark.MaxDrawElements"),
+	0,
+	TEXT("Draw elements a configuration may paint in a frame at any resolution. Zero disables the budget."));
+
+namespace LoadingScreenBenchmark
+{
+	const float FrameDeltaTime = 1.0f / 60.0f;
+
+	/** Cost of a configuration at one resolution */
+	struct FResult
+	{
+		FString Configuration;
+		FIntPoint Resolution;
+		double ConstructMs = 0.0;
+		double MaxConstructMs = 0.0;
+		double PrepassMs = 0.0;
+		double PaintMs = 0.0;
+		int32 NumDrawElements = 0;
+	};
+
+	TArray<FIntPoint> ParseResolutions()
+	{
+		TArray<FString> Values;
+		CVarBenchmarkResolutions.GetValueOnGameThread().ParseIntoArray(Values, TEXT(","));
+
+		TArray<FIntPoint> Resolutions;
+		for (const FString& Value : Values)
+		{
+			FString Width, Height;
+			if (Value.TrimStartAndEnd().Split(TEXT("x"), &Width, &Height) && FCString::Atoi(*Width) > 0 && FCString::Atoi(*Height) > 0)
+			{
+				Resolutions.Add(FIntPoint(FCString::Atoi(*Width), FCString::Atoi(*Height)));
+			}
+		}
+		return Resolutions;
+	}
+
+	/** Prepasses and paints the layout at the resolution, like the loading thread would, but into an element list nobody renders */
+	void MeasurePaint(const TSharedRef<SLoadingScreenLayout>& Layout, const FIntPoint& Resolution, int32 NumIterations, FResult& OutResult)
+	{
+		const TSharedRef<SWindow> Window = SNew(SWindow).ClientSize(FVector2D(Resolution));
+		FSlateWindowElementList ElementList(Window);
+		FHittestGrid HittestGrid;
+
+		const FGeometry Geometry = FGeometry::MakeRoot(FVector2D(Resolution), FSlateLayoutTransform());
+		const FSlateRect CullingRect(0.0f, 0.0f, Resolution.X, Resolution.Y);
+		const double StartTime = FSlateApplication::Get().GetCurrentTime();
+
+		uint64 PrepassCycles = 0;
+		uint64 PaintCycles = 0;
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			ElementList.ResetElementList();
+
+			const uint64 PrepassStartCycles = FPlatformTime::Cycles64();
+			Layout->SlatePrepass(1.0f);
+			const uint64 PaintStartCycles = FPlatformTime::Cycles64();
+
+			// Advance the clock, so the throbbers paint a different frame every time
+			FPaintArgs PaintArgs(nullptr, HittestGrid, FVector2D::ZeroVector, StartTime + Iteration * FrameDeltaTime, FrameDeltaTime);
+			Layout->Paint(PaintArgs, Geometry, CullingRect, ElementList, 0, FWidgetStyle(), true);
+
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			PrepassCycles += PaintStartCycles - PrepassStartCycles;
+			PaintCycles += EndCycles - PaintStartCycles;
+			OutResult.NumDrawElements = FMath::Max(OutResult.NumDrawElements, ElementList.GetUncachedDrawElements().Num());
+		}
+
+		OutResult.PrepassMs = FPlatformTime::ToMilliseconds64(PrepassCycles) / NumIterations;
+		OutResult.PaintMs = FPlatformTime::ToMilliseconds64(PaintCycles) / NumIterations;
+	}
+
+	/** Constructs the configuration the given number of times and measures its paint at every resolution */
+	void BenchmarkConfiguration(const FALoadingScreenSettings& Settings, const FString& Configuration, const TArray<FIntPoint>& Resolutions, int32 NumIterations, TArray<FResult>& OutResults)
+	{
+		FAsyncLoadingScreenModule& Module = FAsyncLoadingScreenModule::Get();
+
+		uint64 ConstructCycles = 0;
+		uint64 MaxConstructCycles = 0;
+		TSharedPtr<SLoadingScreenLayout> Layout;
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			if (Layout.IsValid())
+			{
+				Layout->ReleaseResources();
+			}
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Layout = Module.ConstructLayout(Settings);
+			const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+			ConstructCycles += Cycles;
+			MaxConstructCycles = FMath::Max(MaxConstructCycles, Cycles);
+		}
+
+		for (const FIntPoint& Resolution : Resolutions)
+		{
+			FResult& Result = OutResults.AddDefaulted_GetRef();
+			Result.Configuration = Configuration;
+			Result.Resolution = Resolution;
+			Result.ConstructMs = FPlatformTime::ToMilliseconds64(ConstructCycles) / NumIterations;
+			Result.MaxConstructMs = FPlatformTime::ToMilliseconds64(MaxConstructCycles);
+			MeasurePaint(Layout.ToSharedRef(), Resolution, NumIterations, Result);
+		}
+
+		Layout->ReleaseResources();
+	}
+
+	/** Reports the results that are over budget as errors of the test */
+	void CheckBudgets(const TArray<FResult>& Results, FAutomationTestBase& Test)
+	{
+		const float ConstructBudget = CVarBenchmarkConstructBudget.GetValueOnGameThread();
+		const float PaintBudget = CVarBenchmarkPaintBudget.GetValueOnGameThread();
+		const int32 DrawElementBudget = CVarBenchmarkDrawElementBudget.GetValueOnGameThread();
+
+		for (const FResult& Result : Results)
+		{
+			const double PaintMs = Result.PrepassMs + Result.PaintMs;
+			if ((ConstructBudget > 0.0f && Result.ConstructMs > ConstructBudget) || (PaintBudget > 0.0f && PaintMs > PaintBudget)
+				|| (DrawElementBudget > 0 && Result.NumDrawElements > DrawElementBudget))
+			{
+				Test.AddError(FString::Printf(TEXT("%s at %dx%d is over budget: construct %.3f ms (budget %.3f), paint %.3f ms (budget %.3f), %d draw elements (budget %d)."),
+					*Result.Configuration, Result.Resolution.X, Result.Resolution.Y, Result.ConstructMs, ConstructBudget, PaintMs, PaintBudget, Result.NumDrawElements, DrawElementBudget));
+			}
+		}
+	}
+
+	/** Writes the results to Saved/Profiling, so runs can be compared */
+	void SaveResults(const TArray<FResult>& Results, const TCHAR* FileName)
+	{
+		TArray<FString> Lines;
+		Lines.Add(TEXT("Configuration,Resolution,ConstructMs,MaxConstructMs,PrepassMs,PaintMs,DrawElements"));
+		for (const FResult& Result : Results)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,%dx%d,%.4f,%.4f,%.4f,%.4f,%d"), *Result.Configuration, Result.Resolution.X, Result.Resolution.Y,
+				Result.ConstructMs, Result.MaxConstructMs, Result.PrepassMs, Result.PaintMs, Result.NumDrawElements));
+		}
+
+		const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), FileName);
+		if (FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+		{
+			UE_LOG(LogAsyncLoadingScreen, Display, TEXT("Benchmark results written to %s."), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Couldn't write the benchmark results to %s."), *FilePath);
+		}
+	}
+
+	/** Benchmarks every layout, loading icon and loading widget combination of the default loading screen, returns false if the test can't run */
+	bool Run(bool bLightweight, FAutomationTestBase& Test)
+	{
+		if (!FSlateApplication::IsInitialized())
+		{
+			Test.AddError(TEXT("The benchmark needs Slate, run it in a game or with -nullrhi rather than in a commandlet."));
+			return false;
+		}
+
+		const int32 NumIterations = FMath::Max(CVarBenchmarkIterations.GetValueOnGameThread(), 1);
+		const TArray<FIntPoint> Resolutions = ParseResolutions();
+		if (Resolutions.Num() == 0)
+		{
+			Test.AddError(TEXT("No valid resolution in AsyncLoadingScreen.Benchmark.Resolutions."));
+			return false;
+		}
+
+		// Every configuration starts from the default loading screen, so the images, fonts and tips are the project's own
+		FALoadingScreenSettings Settings = GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen;
+		Settings.bShowWidgetOverlay = true;
+		Settings.bUseLightweightLayout = bLightweight;
+
+		const UEnum* LayoutEnum = StaticEnum<EAsyncLoadingScreenLayout>();
+		const UEnum* IconTypeEnum = StaticEnum<ELoadingIconType>();
+		const UEnum* WidgetTypeEnum = StaticEnum<ELoadingWidgetType>();
+		const EAsyncLoadingScreenLayout Layouts[] = { EAsyncLoadingScreenLayout::ALSL_Classic, EAsyncLoadingScreenLayout::ALSL_Center,
+			EAsyncLoadingScreenLayout::ALSL_Letterbox, EAsyncLoadingScreenLayout::ALSL_Sidebar, EAsyncLoadingScreenLayout::ALSL_DualSidebar };
+		const ELoadingIconType IconTypes[] = { ELoadingIconType::LIT_Throbber, ELoadingIconType::LIT_CircularThrobber,
+			ELoadingIconType::LIT_ImageSequence, ELoadingIconType::LIT_BatchedThrobber };
+		const ELoadingWidgetType WidgetTypes[] = { ELoadingWidgetType::LWT_Horizontal, ELoadingWidgetType::LWT_Vertical };
+
+		const int32 NumConfigurations = UE_ARRAY_COUNT(Layouts) * UE_ARRAY_COUNT(IconTypes) * UE_ARRAY_COUNT(WidgetTypes);
+		Test.AddInfo(FString::Printf(TEXT("Benchmarking %d configurations, %d iterations each, at %d resolutions%s."),
+			NumConfigurations, NumIterations, Resolutions.Num(), bLightweight ? TEXT(" with the lightweight layout") : TEXT("")));
+
+		TArray<FResult> Results;
+		for (EAsyncLoadingScreenLayout Layout : Layouts)
+		{
+			for (ELoadingIconType IconType : IconTypes)
+			{
+				for (ELoadingWidgetType WidgetType : WidgetTypes)
+				{
+					Settings.Layout = Layout;
+					Settings.LoadingWidget.LoadingIconType = IconType;
+					Settings.LoadingWidget.LoadingWidgetType = WidgetType;
+
+					FString Configuration = FString::Printf(TEXT("%s %s %s"), *LayoutEnum->GetNameStringByValue(static_cast<int64>(Layout)),
+						*IconTypeEnum->GetNameStringByValue(static_cast<int64>(IconType)), *WidgetTypeEnum->GetNameStringByValue(static_cast<int64>(WidgetType)));
+					if (bLightweight && !SLightweightLayout::CanRender(Settings))
+					{
+						Configuration += TEXT(" (regular layout)");
+					}
+
+					const int32 FirstResult = Results.Num();
+					BenchmarkConfiguration(Settings, Configuration, Resolutions, NumIterations, Results);
+
+					for (int32 Index = FirstResult; Index < Results.Num(); Index++)
+					{
+						const FResult& Result = Results[Index];
+						Test.AddInfo(FString::Printf(TEXT("%s at %dx%d: construct %.3f ms (max %.3f ms), prepass %.3f ms, paint %.3f ms, %d draw elements."),
+							*Result.Configuration, Result.Resolution.X, Result.Resolution.Y, Result.ConstructMs, Result.MaxConstructMs, Result.PrepassMs, Result.PaintMs, Result.NumDrawElements));
+					}
+				}
+			}
+		}
+
+		SaveResults(Results, bLightweight ? TEXT("AsyncLoadingScreenBenchmarkLightweight.csv") : TEXT("AsyncLoadingScreenBenchmark.csv"));
+		CheckBudgets(Results, Test);
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadingScreenBenchmarkTest, "AsyncLoadingScreen.Benchmark.Layouts",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLoadingScreenBenchmarkTest::RunTest(const FString& Parameters)
+{
+	return LoadingScreenBenchmark::Run(false, *this);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoadingScreenLightweightBenchmarkTest, "AsyncLoadingScreen.Benchmark.LightweightLayouts",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FLoadingScreenLightweightBenchmarkTest::RunTest(const FString& Parameters)
+{
+	return LoadingScreenBenchmark::Run(true, *this);
+}
+
+#endif
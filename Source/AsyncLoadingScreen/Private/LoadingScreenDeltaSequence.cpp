@@ -0,0 +1,307 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenDeltaSequence.h"
+#include "Misc/Compression.h"
+#include "AsyncLoadingScreen.h"
+
+#if WITH_EDITOR
+#include "Engine/Texture2D.h"
+#include "LoadingScreenSourceFrames.h"
+
+namespace
+{
+	/** Finds the tiles that differ between the two frames and merges them into rects, runs of tiles in a row first, then identical runs of consecutive rows */
+	void FindDirtyRects(const TArray64<uint8>& Previous, const TArray64<uint8>& Current, const FIntPoint& FrameSize, int32 TileSize, TArray<FIntRect>& OutRects)
+	{
+		// Rects that ended on the previous tile row and can still grow downwards
+		TArray<int32> OpenRects;
+
+		for (int32 TileY = 0; TileY < FrameSize.Y; TileY += TileSize)
+		{
+			const int32 TileBottom = FMath::Min(TileY + TileSize, FrameSize.Y);
+			TArray<int32> RowRects;
+			int32 RunStart = INDEX_NONE;
+
+			// One pass past the last tile closes the run that reaches the right edge, whether the width is a multiple of the tile size or not
+			const int32 PaddedWidth = FMath::DivideAndRoundUp(FrameSize.X, TileSize) * TileSize;
+			for (int32 TileX = 0; TileX <= PaddedWidth; TileX += TileSize)
+			{
+				bool bTileDirty = false;
+				if (TileX < FrameSize.X)
+				{
+					const int32 TileWidth = FMath::Min(TileSize, FrameSize.X - TileX);
+					for (int32 Y = TileY; Y < TileBottom && !bTileDirty; ++Y)
+					{
+						const int64 Offset = (static_cast<int64>(Y) * FrameSize.X + TileX) * 4;
+						bTileDirty = FMemory::Memcmp(&Previous[Offset], &Current[Offset], TileWidth * 4) != 0;
+					}
+				}
+
+				if (bTileDirty && RunStart == INDEX_NONE)
+				{
+					RunStart = TileX;
+				}
+				else if (!bTileDirty && RunStart != INDEX_NONE)
+				{
+					const FIntRect Run(RunStart, TileY, FMath::Min(TileX, FrameSize.X), TileBottom);
+					RunStart = INDEX_NONE;
+
+					// Grow the rect above if it spans the same columns
+					const int32* OpenRect = OpenRects.FindByPredicate([&](int32 RectIndex)
+					{
+						return OutRects[RectIndex].Min.X == Run.Min.X && OutRects[RectIndex].Max.X == Run.Max.X;
+					});
+
+					if (OpenRect)
+					{
+						OutRects[*OpenRect].Max.Y = Run.Max.Y;
+						RowRects.Add(*OpenRect);
+					}
+					else
+					{
+						RowRects.Add(OutRects.Add(Run));
+					}
+				}
+			}
+
+			OpenRects = MoveTemp(RowRects);
+		}
+	}
+}
+#endif
+
+void ULoadingScreenDeltaSequence::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	CompressedFrames.BulkSerialize(Ar);
+}
+
+void ULoadingScreenDeltaSequence::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(CompressedFrames.GetAllocatedSize());
+}
+
+int32 ULoadingScreenDeltaSequence::GetKeyframeIndex(int32 FrameIndex) const
+{
+	for (int32 Index = FMath::Min(FrameIndex, Frames.Num() - 1); Index > 0; --Index)
+	{
+		if (Frames[Index].bKeyframe)
+		{
+			return Index;
+		}
+	}
+
+	return 0;
+}
+
+bool ULoadingScreenDeltaSequence::DecodeFrame(int32 FrameIndex, uint8* FramePixels) const
+{
+	if (!Frames.IsValidIndex(FrameIndex))
+	{
+		return false;
+	}
+
+	const FLoadingScreenDeltaFrame& Frame = Frames[FrameIndex];
+	if (Frame.UncompressedSize == 0)
+	{
+		// Nothing changed since the previous frame
+		return true;
+	}
+
+	if (Frame.CompressedOffset < 0 || Frame.CompressedOffset + Frame.CompressedSize > CompressedFrames.Num())
+	{
+		return false;
+	}
+
+	TArray<uint8> RectPixels;
+	RectPixels.SetNumUninitialized(Frame.UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, RectPixels.GetData(), Frame.UncompressedSize, &CompressedFrames[Frame.CompressedOffset], Frame.CompressedSize))
+	{
+		return false;
+	}
+
+	const uint8* Source = RectPixels.GetData();
+	for (const FIntRect& Rect : Frame.DirtyRects)
+	{
+		const int32 RowSize = Rect.Width() * 4;
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			FMemory::Memcpy(FramePixels + (static_cast<int64>(Y) * FrameSize.X + Rect.Min.X) * 4, Source, RowSize);
+			Source += RowSize;
+		}
+	}
+
+	return true;
+}
+
+#if WITH_EDITOR
+void ULoadingScreenDeltaSequence::BuildSequence()
+{
+	TArray<UTexture2D*> SourceTextures;
+	FLoadingScreenSourceFrames::Gather(SourceFrames, SourceFolder, SourceTextures);
+
+	if (SourceTextures.Num() == 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Delta sequence %s has no source frames."), *GetName());
+		return;
+	}
+
+	FrameSize = FIntPoint(SourceTextures[0]->Source.GetSizeX(), SourceTextures[0]->Source.GetSizeY());
+	const int32 FrameBytes = FrameSize.X * FrameSize.Y * 4;
+
+	Frames.Reset(SourceTextures.Num());
+	CompressedFrames.Reset();
+
+	TArray64<uint8> PreviousPixels;
+	for (UTexture2D* SourceTexture : SourceTextures)
+	{
+		TArray64<uint8> Pixels;
+		if (!FLoadingScreenSourceFrames::ReadPixels(SourceTexture, FrameSize, Pixels))
+		{
+			continue;
+		}
+
+		FLoadingScreenDeltaFrame& Frame = Frames.AddDefaulted_GetRef();
+		Frame.bKeyframe = (Frames.Num() - 1) % KeyframeInterval == 0;
+
+		if (!Frame.bKeyframe)
+		{
+			FindDirtyRects(PreviousPixels, Pixels, FrameSize, TileSize, Frame.DirtyRects);
+
+			// Store a keyframe instead if most of the frame changed, it's cheaper to seek from
+			int64 DirtyArea = 0;
+			for (const FIntRect& Rect : Frame.DirtyRects)
+			{
+				DirtyArea += Rect.Area();
+			}
+			Frame.bKeyframe = DirtyArea * 2 > static_cast<int64>(FrameSize.X) * FrameSize.Y;
+		}
+
+		if (Frame.bKeyframe)
+		{
+			Frame.DirtyRects.Reset();
+			Frame.DirtyRects.Add(FIntRect(FIntPoint::ZeroValue, FrameSize));
+		}
+
+		// Gather the pixels of the dirty rects and compress them
+		TArray<uint8> RectPixels;
+		for (const FIntRect& Rect : Frame.DirtyRects)
+		{
+			for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+			{
+				RectPixels.Append(&Pixels[(static_cast<int64>(Y) * FrameSize.X + Rect.Min.X) * 4], Rect.Width() * 4);
+			}
+		}
+
+		Frame.CompressedOffset = CompressedFrames.Num();
+		Frame.UncompressedSize = RectPixels.Num();
+
+		if (RectPixels.Num() > 0)
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RectPixels.Num());
+			CompressedFrames.AddUninitialized(CompressedSize);
+			if (!FCompression::CompressMemory(NAME_Zlib, &CompressedFrames[Frame.CompressedOffset], CompressedSize, RectPixels.GetData(), RectPixels.Num()))
+			{
+				UE_LOG(LogAsyncLoadingScreen, Error, TEXT("Failed to compress frame %d of delta sequence %s."), Frames.Num() - 1, *GetName());
+				Frames.Reset();
+				CompressedFrames.Reset();
+				return;
+			}
+
+			CompressedFrames.SetNum(Frame.CompressedOffset + CompressedSize, false);
+			Frame.CompressedSize = CompressedSize;
+		}
+
+		PreviousPixels = MoveTemp(Pixels);
+	}
+
+	CompressedFrames.Shrink();
+	MarkPackageDirty();
+
+	int32 NumKeyframes = 0;
+	for (const FLoadingScreenDeltaFrame& Frame : Frames)
+	{
+		NumKeyframes += Frame.bKeyframe ? 1 : 0;
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Built delta sequence %s: %d frames (%d keyframes), %.2f KB compressed instead of %.2f KB of raw frames."),
+		*GetName(), Frames.Num(), NumKeyframes, CompressedFrames.Num() / 1024.0f, static_cast<float>(FrameBytes) * Frames.Num() / 1024.0f);
+
+	FString Error;
+	if (!VerifySequence(Error))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Error, TEXT("Delta sequence %s doesn't decode back to its source frames: %s"), *GetName(), *Error);
+	}
+}
+
+bool ULoadingScreenDeltaSequence::VerifySequence(FString& OutError) const
+{
+	TArray<UTexture2D*> SourceTextures;
+	FLoadingScreenSourceFrames::Gather(SourceFrames, SourceFolder, SourceTextures);
+
+	// The frames are decoded one after another into the same buffer, like the player does
+	TArray64<uint8> DecodedPixels;
+	DecodedPixels.SetNumZeroed(static_cast<int64>(FrameSize.X) * FrameSize.Y * 4);
+
+	int32 FrameIndex = 0;
+	for (UTexture2D* SourceTexture : SourceTextures)
+	{
+		// Frames that couldn't be read were skipped by the build too
+		TArray64<uint8> SourcePixels;
+		if (!FLoadingScreenSourceFrames::ReadPixels(SourceTexture, FrameSize, SourcePixels))
+		{
+			continue;
+		}
+
+		if (!Frames.IsValidIndex(FrameIndex))
+		{
+			OutError = FString::Printf(TEXT("%d frames were built, the source has more. Rebuild the sequence."), Frames.Num());
+			return false;
+		}
+
+		if (!DecodeFrame(FrameIndex, DecodedPixels.GetData()))
+		{
+			OutError = FString::Printf(TEXT("frame %d failed to decode."), FrameIndex);
+			return false;
+		}
+
+		if (SourcePixels.Num() != DecodedPixels.Num() || FMemory::Memcmp(SourcePixels.GetData(), DecodedPixels.GetData(), DecodedPixels.Num()) != 0)
+		{
+			OutError = FString::Printf(TEXT("frame %d differs from %s. Rebuild the sequence."), FrameIndex, *SourceTexture->GetName());
+			return false;
+		}
+
+		FrameIndex++;
+	}
+
+	if (FrameIndex != Frames.Num())
+	{
+		OutError = FString::Printf(TEXT("%d frames were built, the source has %d. Rebuild the sequence."), Frames.Num(), FrameIndex);
+		return false;
+	}
+
+	return true;
+}
+
+void ULoadingScreenDeltaSequence::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+
+	// Check every cooked sequence, a delta that lost pixels corrupts all the frames after it until the next keyframe.
+	// Only a warning, the editor-only source frames may have been moved or edited since the build, which mustn't fail the cook.
+	FString Error;
+	if (TargetPlatform && Frames.Num() > 0 && !VerifySequence(Error))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Delta sequence %s doesn't decode back to its source frames: %s"), *GetPathName(), *Error);
+	}
+}
+#endif
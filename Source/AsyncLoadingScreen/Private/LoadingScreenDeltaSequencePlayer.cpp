@@ -0,0 +1,140 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenDeltaSequencePlayer.h"
+#include "LoadingScreenDeltaSequence.h"
+#include "AsyncLoadingScreen.h"
+#include "Engine/Texture2D.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "LoadingScreenTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Decode Delta Sequence Frame"), STAT_DecodeDeltaSequenceFrame, STATGROUP_AsyncLoadingScreen);
+
+FLoadingScreenDeltaSequencePlayer::FLoadingScreenDeltaSequencePlayer(const ULoadingScreenDeltaSequence* InSequence, UTexture2D* InTexture)
+	: Sequence(InSequence)
+	, Texture(InTexture)
+{
+	check(Sequence && Texture);
+}
+
+int32 FLoadingScreenDeltaSequencePlayer::GetNumFrames() const
+{
+	return Sequence->GetNumFrames();
+}
+
+void FLoadingScreenDeltaSequencePlayer::RequestFrame(int32 FrameIndex)
+{
+	RequestedFrame = FrameIndex;
+
+	if (!bIsStopped && !bIsDecoding.Exchange(true))
+	{
+		TSharedRef<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe> Player = AsShared();
+		Async(EAsyncExecution::ThreadPool, [Player]()
+		{
+			Player->DecodeRequestedFrames();
+		});
+	}
+}
+
+void FLoadingScreenDeltaSequencePlayer::Stop()
+{
+	bIsStopped = true;
+
+	// Wait for the frame in flight
+	FScopeLock Lock(&DecodeCS);
+}
+
+void FLoadingScreenDeltaSequencePlayer::DecodeRequestedFrames()
+{
+	while (true)
+	{
+		{
+			FScopeLock Lock(&DecodeCS);
+			const int32 FrameIndex = RequestedFrame;
+			if (!bIsStopped && FrameIndex != DisplayedFrame)
+			{
+				DecodeFrame(FrameIndex);
+				continue;
+			}
+		}
+
+		bIsDecoding = false;
+
+		// Keep going if a frame was requested after the check and no other task picked it up
+		if (bIsStopped || RequestedFrame == DisplayedFrame || bIsDecoding.Exchange(true))
+		{
+			break;
+		}
+	}
+}
+
+void FLoadingScreenDeltaSequencePlayer::DecodeFrame(int32 FrameIndex)
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_DecodeDeltaSequenceFrame);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	const FIntPoint FrameSize = Sequence->FrameSize;
+	const int32 NumFrames = Sequence->GetNumFrames();
+	if (FrameIndex < 0 || FrameIndex >= NumFrames)
+	{
+		DisplayedFrame = FrameIndex;
+		return;
+	}
+
+	// Catch up from the displayed frame when playing forward, otherwise seek from the keyframe
+	const int32 KeyframeIndex = Sequence->GetKeyframeIndex(FrameIndex);
+	const int32 PreviousFrame = DisplayedFrame;
+	const int32 StartIndex = (PreviousFrame != INDEX_NONE && PreviousFrame >= KeyframeIndex && PreviousFrame < FrameIndex) ? PreviousFrame + 1 : KeyframeIndex;
+
+	// Only the dirty rects are written, the rest of the buffer is never uploaded. Frames decoded later overwrite
+	// the rects they share with earlier ones, so the union of their rects holds the requested frame.
+	uint8* FramePixels = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(FrameSize.X) * FrameSize.Y * 4));
+	TArray<FIntRect> DirtyRects;
+	bool bDecoded = true;
+	for (int32 Index = StartIndex; Index <= FrameIndex && bDecoded; ++Index)
+	{
+		bDecoded = Sequence->DecodeFrame(Index, FramePixels);
+		DirtyRects.Append(Sequence->Frames[Index].DirtyRects);
+	}
+
+	if (StartIndex == KeyframeIndex)
+	{
+		DirtyRects.Reset();
+		DirtyRects.Add(FIntRect(FIntPoint::ZeroValue, FrameSize));
+	}
+
+
+	if (!bDecoded || DirtyRects.Num() == 0)
+	{
+		if (!bDecoded)
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to decode frame %d of delta sequence %s."), FrameIndex, *Sequence->GetName());
+		}
+
+		FMemory::Free(FramePixels);
+		DisplayedFrame = FrameIndex;
+		return;
+	}
+
+	FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[DirtyRects.Num()];
+	for (int32 Index = 0; Index < DirtyRects.Num(); ++Index)
+	{
+		const FIntRect& Rect = DirtyRects[Index];
+		Regions[Index] = FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, Rect.Min.X, Rect.Min.Y, Rect.Width(), Rect.Height());
+	}
+
+	// The render thread frees the buffers once the regions are uploaded
+	Texture->UpdateTextureRegions(0, DirtyRects.Num(), Regions, FrameSize.X * 4, 4, FramePixels, [](uint8* SrcData, const FUpdateTextureRegion2D* SrcRegions)
+	{
+		FMemory::Free(SrcData);
+		delete[] SrcRegions;
+	});
+
+	DisplayedFrame = FrameIndex;
+}
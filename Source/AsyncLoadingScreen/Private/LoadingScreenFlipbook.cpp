@@ -0,0 +1,82 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenFlipbook.h"
+#include "Engine/Texture2D.h"
+#include "AsyncLoadingScreen.h"
+
+#if WITH_EDITOR
+#include "LoadingScreenSourceFrames.h"
+
+void ULoadingScreenFlipbook::BuildAtlas()
+{
+	TArray<UTexture2D*> Frames;
+	FLoadingScreenSourceFrames::Gather(SourceFrames, SourceFolder, Frames);
+
+	if (Frames.Num() == 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Flipbook %s has no source frames."), *GetName());
+		return;
+	}
+
+	FrameSize = FIntPoint(Frames[0]->Source.GetSizeX(), Frames[0]->Source.GetSizeY());
+
+	// Lay the frames out in a grid as close to a square as possible
+	const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Frames.Num())));
+	const int32 NumRows = FMath::DivideAndRoundUp(Frames.Num(), NumColumns);
+	const int32 CellSizeX = FrameSize.X + FramePadding;
+	const int32 CellSizeY = FrameSize.Y + FramePadding;
+	const int32 AtlasSizeX = NumColumns * CellSizeX - FramePadding;
+	const int32 AtlasSizeY = NumRows * CellSizeY - FramePadding;
+
+	TArray64<uint8> AtlasData;
+	AtlasData.SetNumZeroed(static_cast<int64>(AtlasSizeX) * AtlasSizeY * 4);
+
+	FrameRegions.Reset(Frames.Num());
+
+	for (UTexture2D* Frame : Frames)
+	{
+		TArray64<uint8> FramePixels;
+		if (!FLoadingScreenSourceFrames::ReadPixels(Frame, FrameSize, FramePixels))
+		{
+			continue;
+		}
+
+		const int32 FrameIndex = FrameRegions.Num();
+		const int32 OffsetX = (FrameIndex % NumColumns) * CellSizeX;
+		const int32 OffsetY = (FrameIndex / NumColumns) * CellSizeY;
+
+		for (int32 Y = 0; Y < FrameSize.Y; ++Y)
+		{
+			uint8* Dest = &AtlasData[(static_cast<int64>(OffsetY + Y) * AtlasSizeX + OffsetX) * 4];
+			FMemory::Memcpy(Dest, &FramePixels[static_cast<int64>(Y) * FrameSize.X * 4], FrameSize.X * 4);
+		}
+
+		const FVector2D Min(static_cast<float>(OffsetX) / AtlasSizeX, static_cast<float>(OffsetY) / AtlasSizeY);
+		const FVector2D Max(static_cast<float>(OffsetX + FrameSize.X) / AtlasSizeX, static_cast<float>(OffsetY + FrameSize.Y) / AtlasSizeY);
+		FrameRegions.Add(FBox2D(Min, Max));
+	}
+
+	if (Atlas == nullptr)
+	{
+		Atlas = NewObject<UTexture2D>(this, TEXT("FlipbookAtlas"), RF_Public);
+	}
+
+	Atlas->PreEditChange(nullptr);
+	Atlas->Source.Init(AtlasSizeX, AtlasSizeY, 1, 1, TSF_BGRA8, AtlasData.GetData());
+	Atlas->LODGroup = TEXTUREGROUP_UI;
+	Atlas->MipGenSettings = TMGS_NoMipmaps;
+	Atlas->NeverStream = true;
+	Atlas->SRGB = true;
+	Atlas->PostEditChange();
+
+	MarkPackageDirty();
+
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Built flipbook %s: %d frames packed into a %dx%d atlas."), *GetName(), FrameRegions.Num(), AtlasSizeX, AtlasSizeY);
+}
+#endif
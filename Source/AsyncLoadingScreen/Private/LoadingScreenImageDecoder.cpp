@@ -0,0 +1,130 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenImageDecoder.h"
+#include "AsyncLoadingScreen.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+void FLoadingScreenImageDecoder::FindImageFiles(const FString& Directory, TArray<FString>& OutFiles)
+{
+	static const TCHAR* Extensions[] = { TEXT("*.png"), TEXT("*.jpg"), TEXT("*.jpeg") };
+
+	for (const TCHAR* Extension : Extensions)
+	{
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *FPaths::Combine(Directory, Extension), true, false);
+		for (const FString& FileName : FileNames)
+		{
+			OutFiles.Add(FPaths::Combine(Directory, FileName));
+		}
+	}
+
+	OutFiles.Sort();
+}
+
+bool FLoadingScreenImageDecoder::DecodeImageFile(IImageWrapperModule& ImageWrapperModule, const FString& FilePath, FLoadingScreenDecodedImage& OutImage)
+{
+	TArray<uint8> CompressedData;
+	if (!FFileHelper::LoadFileToArray(CompressedData, *FilePath))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to read image file %s."), *FilePath);
+		return false;
+	}
+
+	const EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(CompressedData.GetData(), CompressedData.Num());
+	if (ImageFormat != EImageFormat::PNG && ImageFormat != EImageFormat::JPEG)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Image file %s is not a PNG or JPEG file."), *FilePath);
+		return false;
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+	const TArray<uint8>* RawData = nullptr;
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(CompressedData.GetData(), CompressedData.Num()) || !ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData) || RawData == nullptr)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to decode image file %s."), *FilePath);
+		return false;
+	}
+
+	OutImage.Size = FIntPoint(ImageWrapper->GetWidth(), ImageWrapper->GetHeight());
+	OutImage.Pixels = *RawData;
+
+	return OutImage.IsValid();
+}
+
+FIntPoint FLoadingScreenImageDecoder::GetDownscaledSize(const FIntPoint& Size, float Scale)
+{
+	if (Scale >= 1.0f || Scale <= 0.0f)
+	{
+		return Size;
+	}
+
+	return FIntPoint(FMath::Max(1, FMath::CeilToInt(Size.X * Scale)), FMath::Max(1, FMath::CeilToInt(Size.Y * Scale)));
+}
+
+void FLoadingScreenImageDecoder::Downscale(const FLoadingScreenDecodedImage& Source, const FIntPoint& TargetSize, FLoadingScreenDecodedImage& OutImage)
+{
+	check(Source.IsValid() && TargetSize.X > 0 && TargetSize.Y > 0);
+
+	if (TargetSize == Source.Size)
+	{
+		OutImage = Source;
+		return;
+	}
+
+	OutImage.Size = TargetSize;
+	OutImage.Pixels.SetNumUninitialized(TargetSize.X * TargetSize.Y * 4);
+
+	// Source column span of every destination column, it's the same for every row
+	TArray<FIntPoint> ColumnSpans;
+	ColumnSpans.SetNumUninitialized(TargetSize.X);
+	for (int32 X = 0; X < TargetSize.X; ++X)
+	{
+		const int32 Begin = (int64)X * Source.Size.X / TargetSize.X;
+		const int32 End = FMath::Max(Begin + 1, (int32)((int64)(X + 1) * Source.Size.X / TargetSize.X));
+		ColumnSpans[X] = FIntPoint(Begin, End);
+	}
+
+	const uint8* SourcePixels = Source.Pixels.GetData();
+	uint8* TargetPixels = OutImage.Pixels.GetData();
+	const int32 SourcePitch = Source.Size.X * 4;
+
+	ParallelFor(TargetSize.Y, [&](int32 Y)
+	{
+		const int32 RowBegin = (int64)Y * Source.Size.Y / TargetSize.Y;
+		const int32 RowEnd = FMath::Max(RowBegin + 1, (int32)((int64)(Y + 1) * Source.Size.Y / TargetSize.Y));
+		uint8* TargetRow = TargetPixels + Y * TargetSize.X * 4;
+
+		for (int32 X = 0; X < TargetSize.X; ++X)
+		{
+			const FIntPoint& Span = ColumnSpans[X];
+
+			// Sum the BGRA channels of the source box at once
+			VectorRegister Sum = VectorZero();
+			for (int32 SourceY = RowBegin; SourceY < RowEnd; ++SourceY)
+			{
+				const uint8* SourcePixel = SourcePixels + SourceY * SourcePitch + Span.X * 4;
+				for (int32 SourceX = Span.X; SourceX < Span.Y; ++SourceX, SourcePixel += 4)
+				{
+					Sum = VectorAdd(Sum, VectorLoadByte4(SourcePixel));
+				}
+			}
+
+			// Average and round to nearest, the store truncates
+			const float InvCount = 1.0f / ((RowEnd - RowBegin) * (Span.Y - Span.X));
+			const VectorRegister Average = VectorMultiplyAdd(Sum, VectorSetFloat1(InvCount), VectorSetFloat1(0.5f));
+			VectorStoreByte4(VectorMin(Average, VectorSetFloat1(255.0f)), TargetRow + X * 4);
+		}
+	});
+}
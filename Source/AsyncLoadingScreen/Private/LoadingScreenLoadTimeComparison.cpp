@@ -0,0 +1,415 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenLoadTimeComparison.h"
+#include "AsyncLoadingScreen.h"
+#include "MoviePlayer.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<float> CVarComparisonSettleTime(
+	TEXT("AsyncLoadingScreen.CompareLoadTimes.SettleTime"),
+	2.0f,
+	TEXT("Seconds the load time comparison waits after a loading screen is gone before traveling to the next map, so streaming settles."));
+
+static TAutoConsoleVariable<float> CVarComparisonTravelTimeout(
+	TEXT("AsyncLoadingScreen.CompareLoadTimes.TravelTimeout"),
+	60.0f,
+	TEXT("Seconds the load time comparison waits for a travel to start loading the map before giving up."));
+
+static TAutoConsoleVariable<int32> CVarComparisonWarmUp(
+	TEXT("AsyncLoadingScreen.CompareLoadTimes.WarmUp"),
+	1,
+	TEXT("Whether the load time comparison first travels to every map once without measuring, so the first configuration doesn't pay for the cold caches."));
+
+namespace LoadingScreenLoadTimeComparison
+{
+	/** Mean and standard deviation of a value over the samples of a configuration */
+	struct FDistribution
+	{
+		double Mean = 0.0;
+		double StdDev = 0.0;
+		double Min = 0.0;
+		double Max = 0.0;
+
+		explicit FDistribution(const TArray<double>& Values)
+		{
+			if (Values.Num() == 0)
+			{
+				return;
+			}
+
+			Min = Values[0];
+			Max = Values[0];
+			for (double Value : Values)
+			{
+				Mean += Value;
+				Min = FMath::Min(Min, Value);
+				Max = FMath::Max(Max, Value);
+			}
+			Mean /= Values.Num();
+
+			if (Values.Num() > 1)
+			{
+				double SquaredDeviations = 0.0;
+				for (double Value : Values)
+				{
+					SquaredDeviations += FMath::Square(Value - Mean);
+				}
+				StdDev = FMath::Sqrt(SquaredDeviations / (Values.Num() - 1));
+			}
+		}
+	};
+
+	/** World of the game the maps are traveled from */
+	UWorld* FindGameWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (Context.WorldType == EWorldType::Game && Context.World())
+			{
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+}
+
+FLoadingScreenLoadTimeComparison::FLoadingScreenLoadTimeComparison(const TArray<FString>& InMapNames, int32 InNumRuns)
+	: Configurations(MakeConfigurations())
+	, MapNames(InMapNames)
+	, NumRuns(FMath::Max(InNumRuns, 1))
+{
+}
+
+FLoadingScreenLoadTimeComparison::~FLoadingScreenLoadTimeComparison()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+bool FLoadingScreenLoadTimeComparison::Start()
+{
+	if (MapNames.Num() == 0 || !LoadingScreenLoadTimeComparison::FindGameWorld())
+	{
+		return false;
+	}
+
+	if (GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen.MoviePaths.Num() == 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("The default loading screen has no movies, the MovieOnly configuration shows no loading screen either."));
+	}
+
+	const IConsoleVariable* MaxFrameRateVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("AsyncLoadingScreen.MaxFrameRate"));
+	if (MaxFrameRateVariable && MaxFrameRateVariable->GetFloat() >= 0.0f)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("AsyncLoadingScreen.MaxFrameRate overrides the frame rate caps the comparison goes through, set it to -1 to compare them."));
+	}
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FLoadingScreenLoadTimeComparison::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FLoadingScreenLoadTimeComparison::OnPostLoadMap);
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLoadingScreenLoadTimeComparison::Tick));
+
+	Step = 0;
+	NumWarmUpSteps = CVarComparisonWarmUp.GetValueOnGameThread() != 0 ? MapNames.Num() : 0;
+	State = EState::Ready;
+	Samples.Reset();
+
+	UE_LOG(LogAsyncLoadingScreen, Display, TEXT("Comparing the load times of %d maps over %d runs with %d loading screen configurations%s."),
+		MapNames.Num(), NumRuns, Configurations.Num(), NumWarmUpSteps > 0 ? TEXT(", after a warm-up pass") : TEXT(""));
+	return true;
+}
+
+void FLoadingScreenLoadTimeComparison::Stop()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	PreLoadMapHandle.Reset();
+	PostLoadMapHandle.Reset();
+	TickerHandle.Reset();
+
+	Report();
+}
+
+const FALoadingScreenSettings* FLoadingScreenLoadTimeComparison::GetLoadingScreenOverride() const
+{
+	const int32 ConfigurationIndex = GetConfigurationIndex();
+	return IsRunning() && Configurations.IsValidIndex(ConfigurationIndex) ? &Configurations[ConfigurationIndex].Settings : nullptr;
+}
+
+bool FLoadingScreenLoadTimeComparison::IsWarmUpStep() const
+{
+	return Step < NumWarmUpSteps;
+}
+
+int32 FLoadingScreenLoadTimeComparison::GetConfigurationIndex() const
+{
+	// The warm-up shows no loading screen, after it the configuration changes on every travel so drift over time affects them all alike
+	return IsWarmUpStep() ? 0 : (Step - NumWarmUpSteps) % Configurations.Num();
+}
+
+const FString& FLoadingScreenLoadTimeComparison::GetMapName() const
+{
+	// Every configuration loads a map before the next map is traveled to
+	return IsWarmUpStep() ? MapNames[Step] : MapNames[((Step - NumWarmUpSteps) / Configurations.Num()) % MapNames.Num()];
+}
+
+void FLoadingScreenLoadTimeComparison::OnPreLoadMap(const FString& MapName)
+{
+	if (State != EState::Traveling)
+	{
+		return;
+	}
+
+	State = EState::Loading;
+	LoadStartTime = FPlatformTime::Seconds();
+	LoadStartFlushTime = GFlushAsyncLoadingTime;
+	LoadStartSyncLoadCount = GSyncLoadCount;
+
+	CurrentSample = FSample();
+	CurrentSample.Configuration = Configurations[GetConfigurationIndex()].Name;
+	CurrentSample.MapName = MapName;
+}
+
+void FLoadingScreenLoadTimeComparison::OnPostLoadMap(UWorld* World)
+{
+	if (State != EState::Loading)
+	{
+		return;
+	}
+
+	CurrentSample.WallTime = FPlatformTime::Seconds() - LoadStartTime;
+	CurrentSample.StallTime = GFlushAsyncLoadingTime - LoadStartFlushTime;
+	CurrentSample.NumSyncLoads = GSyncLoadCount - LoadStartSyncLoadCount;
+
+	State = EState::Settling;
+	StateStartTime = FPlatformTime::Seconds();
+}
+
+bool FLoadingScreenLoadTimeComparison::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	switch (State)
+	{
+	case EState::Ready:
+		if (!TravelToNextMap())
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Load time comparison stopped, there's no game world to travel from."));
+			Stop();
+		}
+		break;
+
+	case EState::Traveling:
+		if (Now - StateStartTime > CVarComparisonTravelTimeout.GetValueOnGameThread())
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Load time comparison stopped, the travel to %s didn't start loading the map."), *GetMapName());
+			Stop();
+		}
+		break;
+
+	case EState::Loading:
+		break;
+
+	case EState::Settling:
+		// The settle time only starts counting once the loading screen is gone
+		if (GetMoviePlayer()->IsMovieCurrentlyPlaying())
+		{
+			StateStartTime = Now;
+		}
+		else if (Now - StateStartTime >= CVarComparisonSettleTime.GetValueOnGameThread())
+		{
+			// The stats of the overlay were recorded when the loading screen finished
+			if (Configurations[GetConfigurationIndex()].bShowsWidgetOverlay)
+			{
+				const FLoadingScreenStats& Stats = FAsyncLoadingScreenModule::Get().GetLastLoadingScreenStats();
+				CurrentSample.OverlayTime = Stats.NumFrames * Stats.AveragePaintTimeMs / 1000.0;
+			}
+
+			if (IsWarmUpStep())
+			{
+				UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Warm-up, %s: loaded in %.3f s, not measured."), *CurrentSample.MapName, CurrentSample.WallTime);
+			}
+			else
+			{
+				UE_LOG(LogAsyncLoadingScreen, Log, TEXT("%s, %s: loaded in %.3f s, %.3f s stalled flushing async loading, %d sync loads, %.3f s painting the overlay."),
+					*CurrentSample.Configuration, *CurrentSample.MapName, CurrentSample.WallTime, CurrentSample.StallTime, CurrentSample.NumSyncLoads, CurrentSample.OverlayTime);
+				Samples.Add(CurrentSample);
+			}
+
+			Step++;
+			State = EState::Ready;
+			if (Step >= NumWarmUpSteps + Configurations.Num() * NumRuns * MapNames.Num())
+			{
+				Stop();
+			}
+		}
+		break;
+	}
+
+	return true;
+}
+
+bool FLoadingScreenLoadTimeComparison::TravelToNextMap()
+{
+	UWorld* World = LoadingScreenLoadTimeComparison::FindGameWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	State = EState::Traveling;
+	StateStartTime = FPlatformTime::Seconds();
+	GEngine->SetClientTravel(World, *GetMapName(), TRAVEL_Absolute);
+	return true;
+}
+
+void FLoadingScreenLoadTimeComparison::Report() const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Configuration,Map,WallTime,StallTime,SyncLoads,OverlayTime"));
+	for (const FSample& Sample : Samples)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%.4f,%.4f,%d,%.4f"), *Sample.Configuration, *Sample.MapName,
+			Sample.WallTime, Sample.StallTime, Sample.NumSyncLoads, Sample.OverlayTime));
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Display, TEXT("Load time comparison, %d loads. Times are mean +- standard deviation [min, max] in seconds."), Samples.Num());
+	for (const FConfiguration& Configuration : Configurations)
+	{
+		TArray<double> WallTimes, StallTimes, OverlayTimes;
+		int32 NumSyncLoads = 0;
+		for (const FSample& Sample : Samples)
+		{
+			if (Sample.Configuration == Configuration.Name)
+			{
+				WallTimes.Add(Sample.WallTime);
+				StallTimes.Add(Sample.StallTime);
+				OverlayTimes.Add(Sample.OverlayTime);
+				NumSyncLoads += Sample.NumSyncLoads;
+			}
+		}
+
+		if (WallTimes.Num() == 0)
+		{
+			continue;
+		}
+
+		const LoadingScreenLoadTimeComparison::FDistribution Wall(WallTimes);
+		const LoadingScreenLoadTimeComparison::FDistribution Stall(StallTimes);
+		const LoadingScreenLoadTimeComparison::FDistribution Overlay(OverlayTimes);
+		UE_LOG(LogAsyncLoadingScreen, Display, TEXT("  %-12s %3d loads, wall %.3f +- %.3f [%.3f, %.3f], stall %.3f +- %.3f [%.3f, %.3f], overlay %.3f +- %.3f, %.1f sync loads per load"),
+			*Configuration.Name, WallTimes.Num(), Wall.Mean, Wall.StdDev, Wall.Min, Wall.Max, Stall.Mean, Stall.StdDev, Stall.Min, Stall.Max,
+			Overlay.Mean, Overlay.StdDev, static_cast<float>(NumSyncLoads) / WallTimes.Num());
+	}
+
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AsyncLoadingScreenLoadTimes.csv"));
+	if (FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Display, TEXT("Load time comparison written to %s."), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Couldn't write the load time comparison to %s."), *FilePath);
+	}
+}
+
+TArray<FLoadingScreenLoadTimeComparison::FConfiguration> FLoadingScreenLoadTimeComparison::MakeConfigurations()
+{
+	// Every configuration starts from the default loading screen, and none of them may hold the loading screen up after the load
+	FALoadingScreenSettings Settings = GetDefault<ULoadingScreenSettings>()->DefaultLoadingScreen;
+	Settings.bWaitForManualStop = false;
+	Settings.bAutoCompleteWhenLoadingCompletes = true;
+
+	TArray<FConfiguration> Result;
+
+	FConfiguration& None = Result.AddDefaulted_GetRef();
+	None.Name = TEXT("None");
+	None.Settings = Settings;
+	None.Settings.MoviePaths.Empty();
+	None.Settings.bShowWidgetOverlay = false;
+
+	FConfiguration& MovieOnly = Result.AddDefaulted_GetRef();
+	MovieOnly.Name = TEXT("MovieOnly");
+	MovieOnly.Settings = Settings;
+	MovieOnly.Settings.bShowWidgetOverlay = false;
+
+	const UEnum* LayoutEnum = StaticEnum<EAsyncLoadingScreenLayout>();
+	const EAsyncLoadingScreenLayout Layouts[] = { EAsyncLoadingScreenLayout::ALSL_Classic, EAsyncLoadingScreenLayout::ALSL_Center,
+		EAsyncLoadingScreenLayout::ALSL_Letterbox, EAsyncLoadingScreenLayout::ALSL_Sidebar, EAsyncLoadingScreenLayout::ALSL_DualSidebar };
+	for (EAsyncLoadingScreenLayout Layout : Layouts)
+	{
+		FConfiguration& Configuration = Result.AddDefaulted_GetRef();
+		Configuration.Name = LayoutEnum->GetNameStringByValue(static_cast<int64>(Layout)).RightChop(5);
+		Configuration.Settings = Settings;
+		Configuration.Settings.bShowWidgetOverlay = true;
+		Configuration.Settings.Layout = Layout;
+		Configuration.bShowsWidgetOverlay = true;
+	}
+
+	// The default layout again at a few frame rate caps, zero leaves it to the movie player which caps the loading thread at 60 frames per second
+	const float FrameRateCaps[] = { 0.0f, 15.0f, 30.0f };
+	for (float FrameRateCap : FrameRateCaps)
+	{
+		FConfiguration& Configuration = Result.AddDefaulted_GetRef();
+		Configuration.Name = FrameRateCap > 0.0f ? FString::Printf(TEXT("Cap%.0ffps"), FrameRateCap) : TEXT("Uncapped");
+		Configuration.Settings = Settings;
+		Configuration.Settings.bShowWidgetOverlay = true;
+		Configuration.Settings.MaxFrameRate = FrameRateCap;
+		Configuration.Settings.MaxIdleFrameRate = 0.0f;
+		Configuration.bShowsWidgetOverlay = true;
+	}
+
+	return Result;
+}
+
+#if !UE_BUILD_SHIPPING
+
+static void CompareLoadTimes(const TArray<FString>& Args)
+{
+	if (Args.Num() == 1 && Args[0] == TEXT("Stop"))
+	{
+		FAsyncLoadingScreenModule::Get().StopLoadTimeComparison();
+		return;
+	}
+
+	if (Args.Num() < 2 || FCString::Atoi(*Args[0]) <= 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Usage: AsyncLoadingScreen.CompareLoadTimes <Runs> <Map> [Map...], or AsyncLoadingScreen.CompareLoadTimes Stop."));
+		return;
+	}
+
+	if (!IsMoviePlayerEnabled())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("The load time comparison needs the movie player, run it in a packaged or standalone game rather than in the editor."));
+		return;
+	}
+
+	const TArray<FString> MapNames(Args.GetData() + 1, Args.Num() - 1);
+	FAsyncLoadingScreenModule::Get().StartLoadTimeComparison(MapNames, FCString::Atoi(*Args[0]));
+}
+
+static FAutoConsoleCommand CompareLoadTimesCommand(
+	TEXT("AsyncLoadingScreen.CompareLoadTimes"),
+	TEXT("Travels between the maps with no loading screen, with the movies only, with the widget overlay of every layout and at a few frame rate caps, and compares the load times.\n")
+	TEXT("Usage: AsyncLoadingScreen.CompareLoadTimes <Runs> <Map> [Map...]. AsyncLoadingScreen.CompareLoadTimes Stop ends the comparison early."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&CompareLoadTimes));
+
+#endif
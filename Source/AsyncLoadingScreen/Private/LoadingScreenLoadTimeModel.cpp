@@ -0,0 +1,235 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenLoadTimeModel.h"
+#include "AsyncLoadingScreen.h"
+#include "MoviePlayer.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace LoadingScreenLoadTimeModel
+{
+	// Weight of the latest session in the smoothed times, the older sessions fade out
+	const float SmoothingFactor = 0.3f;
+
+	const TCHAR* FileHeader = TEXT("Map,Sessions,PreLoadMap,PostLoadMap,FirstFrame,Duration");
+
+	/** Moves the smoothed value towards the new sample, or starts from it */
+	float Smooth(float Smoothed, float Sample, int32 NumSessions)
+	{
+		return NumSessions == 0 ? Sample : FMath::Lerp(Smoothed, Sample, SmoothingFactor);
+	}
+}
+
+FLoadingScreenLoadTimeModel::FLoadingScreenLoadTimeModel()
+{
+	Load();
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FLoadingScreenLoadTimeModel::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FLoadingScreenLoadTimeModel::OnPostLoadMap);
+}
+
+FLoadingScreenLoadTimeModel::~FLoadingScreenLoadTimeModel()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+}
+
+void FLoadingScreenLoadTimeModel::BeginSession()
+{
+	// The map load may have started the session already, the loading screen is set up from PreLoadMap.
+	// A session started by an earlier setup without a map load never showed, it starts over.
+	if (SessionStartTime < 0.0 || PreLoadMapTime < 0.0f)
+	{
+		ResetSession();
+		SessionStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void FLoadingScreenLoadTimeModel::EndSession()
+{
+	if (SessionStartTime < 0.0)
+	{
+		return;
+	}
+
+	const float Duration = GetSessionTime();
+
+	if (!SessionMapName.IsEmpty())
+	{
+		// Map load milestones that didn't happen, e.g. the loading screen was stopped early, count as the end of the session
+		FLoadTimeRecord& Record = Records.FindOrAdd(SessionMapName);
+		Record.PreLoadMapTime = LoadingScreenLoadTimeModel::Smooth(Record.PreLoadMapTime, PreLoadMapTime >= 0.0f ? PreLoadMapTime : Duration, Record.NumSessions);
+		Record.PostLoadMapTime = LoadingScreenLoadTimeModel::Smooth(Record.PostLoadMapTime, PostLoadMapTime >= 0.0f ? PostLoadMapTime : Duration, Record.NumSessions);
+		Record.Duration = LoadingScreenLoadTimeModel::Smooth(Record.Duration, Duration, Record.NumSessions);
+
+		// Unless the engine ticks under the loading screen or it waits to be stopped, the movie player ends it in PostLoadMapWithWorld,
+		// before the world ticks. The first frame is no milestone of such a loading screen, it's left out of the prediction.
+		if (FirstFrameTime >= 0.0f)
+		{
+			Record.FirstFrameTime = LoadingScreenLoadTimeModel::Smooth(Record.FirstFrameTime, FirstFrameTime, Record.FirstFrameTime >= 0.0f ? Record.NumSessions : 0);
+		}
+		else
+		{
+			Record.FirstFrameTime = -1.0f;
+		}
+		Record.NumSessions++;
+
+		if (FirstFrameTime >= 0.0f)
+		{
+			UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loading screen of %s: map load at %.3f s, world loaded at %.3f s, first frame at %.3f s, gone at %.3f s. Expected %.3f s next time."),
+				*SessionMapName, PreLoadMapTime, PostLoadMapTime, FirstFrameTime, Duration, Record.Duration);
+		}
+		else
+		{
+			UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loading screen of %s: map load at %.3f s, world loaded at %.3f s, gone at %.3f s before the first frame. Expected %.3f s next time."),
+				*SessionMapName, PreLoadMapTime, PostLoadMapTime, Duration, Record.Duration);
+		}
+
+		Save();
+	}
+
+	ResetSession();
+}
+
+FLoadingScreenLoadMilestones FLoadingScreenLoadTimeModel::GetExpectedMilestones(const FString& MapName) const
+{
+	FLoadingScreenLoadMilestones Milestones;
+	const FLoadTimeRecord* Record = Records.Find(MapName);
+	if (Record != nullptr && Record->NumSessions > 0)
+	{
+		Milestones.PreLoadMapTime = Record->PreLoadMapTime;
+		Milestones.PostLoadMapTime = Record->PostLoadMapTime;
+		Milestones.FirstFrameTime = Record->FirstFrameTime;
+		Milestones.Duration = Record->Duration;
+	}
+	return Milestones;
+}
+
+void FLoadingScreenLoadTimeModel::ResetSession()
+{
+	SessionStartTime = -1.0;
+	SessionMapName.Reset();
+	PreLoadMapTime = -1.0f;
+	PostLoadMapTime = -1.0f;
+	FirstFrameTime = -1.0f;
+
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	BeginFrameHandle.Reset();
+}
+
+void FLoadingScreenLoadTimeModel::OnPreLoadMap(const FString& MapName)
+{
+	// A session that already saw a map load belongs to an earlier load, its loading screen never came up or never finished
+	if (PreLoadMapTime >= 0.0f)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("Dropped the load time session of %s, the map load showed no loading screen."), *SessionMapName);
+		ResetSession();
+	}
+
+	if (SessionStartTime < 0.0)
+	{
+		SessionStartTime = FPlatformTime::Seconds();
+	}
+	SessionMapName = MapName;
+	PreLoadMapTime = GetSessionTime();
+
+	MapLoadStartedEvent.Broadcast(MapName);
+}
+
+void FLoadingScreenLoadTimeModel::OnPostLoadMap(UWorld* World)
+{
+	if (SessionStartTime < 0.0)
+	{
+		return;
+	}
+
+	// Only the loading screens are timed, a load the movie player didn't cover never ends its session
+	if (!IsMoviePlayerEnabled() || !GetMoviePlayer()->IsMovieCurrentlyPlaying())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("Dropped the load time session of %s, the map load showed no loading screen."), *SessionMapName);
+		ResetSession();
+		return;
+	}
+
+	PostLoadMapTime = GetSessionTime();
+
+	// The world ticks its first frame on the next engine frame
+	if (!BeginFrameHandle.IsValid())
+	{
+		BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FLoadingScreenLoadTimeModel::OnBeginFrame);
+	}
+}
+
+void FLoadingScreenLoadTimeModel::OnBeginFrame()
+{
+	FirstFrameTime = GetSessionTime();
+
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	BeginFrameHandle.Reset();
+}
+
+float FLoadingScreenLoadTimeModel::GetSessionTime() const
+{
+	return static_cast<float>(FPlatformTime::Seconds() - SessionStartTime);
+}
+
+FString FLoadingScreenLoadTimeModel::GetFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AsyncLoadingScreen"), TEXT("LoadTimes.csv"));
+}
+
+void FLoadingScreenLoadTimeModel::Load()
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetFilePath()))
+	{
+		return;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Values;
+		Line.ParseIntoArray(Values, TEXT(","), false);
+		if (Values.Num() != 6 || Line.Equals(LoadingScreenLoadTimeModel::FileHeader))
+		{
+			continue;
+		}
+
+		FLoadTimeRecord Record;
+		Record.NumSessions = FCString::Atoi(*Values[1]);
+		Record.PreLoadMapTime = FCString::Atof(*Values[2]);
+		Record.PostLoadMapTime = FCString::Atof(*Values[3]);
+		Record.FirstFrameTime = FCString::Atof(*Values[4]);
+		Record.Duration = FCString::Atof(*Values[5]);
+		Records.Add(Values[0], Record);
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("Read the load times of %d maps from %s."), Records.Num(), *GetFilePath());
+}
+
+void FLoadingScreenLoadTimeModel::Save() const
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Records.Num() + 1);
+	Lines.Add(LoadingScreenLoadTimeModel::FileHeader);
+
+	for (const TPair<FString, FLoadTimeRecord>& Record : Records)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%.3f"), *Record.Key, Record.Value.NumSessions,
+			Record.Value.PreLoadMapTime, Record.Value.PostLoadMapTime, Record.Value.FirstFrameTime, Record.Value.Duration));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *GetFilePath()))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Couldn't write the load times to %s."), *GetFilePath());
+	}
+}
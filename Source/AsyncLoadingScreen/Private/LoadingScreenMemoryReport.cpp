@@ -0,0 +1,208 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenSettings.h"
+#include "LoadingScreenTrace.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/Font.h"
+#include "Engine/FontFace.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/GCObject.h"
+#include "UObject/UObjectGlobals.h"
+
+#if !UE_BUILD_SHIPPING
+
+static TAutoConsoleVariable<float> CVarMemReportBudget(
+	TEXT("AsyncLoadingScreen.MemReport.BudgetMB"),
+	0.0f,
+	TEXT("Resident loading screen assets may take this many megabytes, AsyncLoadingScreen.MemReport logs an error above it. Zero disables the budget."));
+
+namespace LoadingScreenMemoryReport
+{
+	/** Loading screen settings referencing each asset, e.g. "Default Background 2" */
+	typedef TMap<FSoftObjectPath, TArray<FString>> FAssetOwners;
+
+	void AddAsset(FAssetOwners& Owners, const FSoftObjectPath& Path, const FString& Owner)
+	{
+		if (!Path.IsNull())
+		{
+			Owners.FindOrAdd(Path).AddUnique(Owner);
+		}
+	}
+
+	void GatherFontAssets(FAssetOwners& Owners, const FSlateFontInfo& Font, const FString& Owner)
+	{
+		if (const UFont* FontObject = Cast<const UFont>(Font.FontObject))
+		{
+			AddAsset(Owners, FSoftObjectPath(FontObject), Owner);
+			for (const FTypefaceEntry& TypefaceEntry : FontObject->CompositeFont.DefaultTypeface.Fonts)
+			{
+				if (const UObject* FontFaceAsset = TypefaceEntry.Font.GetFontFaceAsset())
+				{
+					AddAsset(Owners, FSoftObjectPath(FontFaceAsset), Owner + TEXT(" Face"));
+				}
+			}
+		}
+	}
+
+	/** Every asset the loading screen settings reference, whether it's shown or not */
+	void GatherSettingsAssets(FAssetOwners& Owners, const FALoadingScreenSettings& Settings, const FString& Name)
+	{
+		for (int32 Index = 0; Index < Settings.Background.Images.Num(); Index++)
+		{
+			AddAsset(Owners, Settings.Background.Images[Index], FString::Printf(TEXT("%s Background %d"), *Name, Index));
+		}
+
+		const FImageSequenceSettings& ImageSequence = Settings.LoadingWidget.ImageSequenceSettings;
+		AddAsset(Owners, ImageSequence.Flipbook.ToSoftObjectPath(), Name + TEXT(" Flipbook"));
+		AddAsset(Owners, ImageSequence.DeltaSequence.ToSoftObjectPath(), Name + TEXT(" Delta Sequence"));
+		for (int32 Index = 0; Index < ImageSequence.Images.Num(); Index++)
+		{
+			AddAsset(Owners, ImageSequence.Images[Index].ToSoftObjectPath(), FString::Printf(TEXT("%s Loading Icon %d"), *Name, Index));
+		}
+
+		GatherFontAssets(Owners, Settings.TipWidget.Appearance.Font, Name + TEXT(" Tip Font"));
+		GatherFontAssets(Owners, Settings.LoadingWidget.Appearance.Font, Name + TEXT(" Loading Font"));
+	}
+
+	/** Objects keeping the asset alive, the Slate brushes and streamable handles show up as the GC object referencer */
+	FString GetReferencers(UObject* Object)
+	{
+		TArray<FString> Referencers;
+		if (Object->IsRooted())
+		{
+			Referencers.Add(TEXT("Root Set"));
+		}
+
+		FReferencerInformationList References;
+		if (IsReferenced(Object, RF_NoFlags, EInternalObjectFlags::GarbageCollectionKeepFlags, true, &References))
+		{
+			for (const FReferencerInformation& Reference : References.ExternalReferences)
+			{
+				if (Reference.Referencer == FGCObject::GGCObjectReferencer)
+				{
+					Referencers.AddUnique(TEXT("Slate brushes and handles (FGCObject)"));
+				}
+				else if (Reference.Referencer)
+				{
+					Referencers.AddUnique(Reference.Referencer->GetPathName());
+				}
+			}
+		}
+
+		return Referencers.Num() > 0 ? FString::Join(Referencers, TEXT(", ")) : TEXT("Nothing, collected by the next GC");
+	}
+
+	/** Debug names of the plugin's streamable handles holding the asset */
+	FString GetStreamableHandles(const FSoftObjectPath& Path)
+	{
+		TArray<TSharedRef<FStreamableHandle>> Handles;
+		FAsyncLoadingScreenModule::Get().GetStreamableManager().GetActiveHandles(Path, Handles);
+
+		TArray<FString> DebugNames;
+		for (const TSharedRef<FStreamableHandle>& Handle : Handles)
+		{
+			DebugNames.AddUnique(Handle->GetDebugName());
+		}
+		return FString::Join(DebugNames, TEXT(", "));
+	}
+
+	void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		LLM_SCOPE_LOADING_SCREEN();
+
+		const ULoadingScreenSettings* Settings = GetDefault<ULoadingScreenSettings>();
+
+		FAssetOwners Owners;
+		GatherSettingsAssets(Owners, Settings->StartupLoadingScreen, TEXT("Startup"));
+		GatherSettingsAssets(Owners, Settings->DefaultLoadingScreen, TEXT("Default"));
+
+		TArray<FSoftObjectPath> SessionAssets;
+		FAsyncLoadingScreenModule::Get().GatherSessionAssets(SessionAssets);
+
+		struct FEntry
+		{
+			FString Path;
+			SIZE_T Size = 0;
+			bool bIsNeeded = false;
+			FString Owners;
+			FString Handles;
+			FString Referencers;
+		};
+
+		TArray<FEntry> Entries;
+		int32 NumNotResident = 0;
+		for (const TPair<FSoftObjectPath, TArray<FString>>& Owner : Owners)
+		{
+			UObject* Object = Owner.Key.ResolveObject();
+			if (!Object)
+			{
+				NumNotResident++;
+				continue;
+			}
+
+			FEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Path = Owner.Key.ToString();
+			Entry.Size = Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			Entry.bIsNeeded = SessionAssets.Contains(Owner.Key);
+			Entry.Owners = FString::Join(Owner.Value, TEXT(", "));
+			Entry.Handles = GetStreamableHandles(Owner.Key);
+			Entry.Referencers = GetReferencers(Object);
+		}
+
+		Entries.Sort([](const FEntry& A, const FEntry& B) { return A.Size > B.Size; });
+
+		SIZE_T TotalSize = 0;
+		SIZE_T UnneededSize = 0;
+		Ar.Logf(TEXT("Resident loading screen assets:"));
+		for (const FEntry& Entry : Entries)
+		{
+			TotalSize += Entry.Size;
+			UnneededSize += Entry.bIsNeeded ? 0 : Entry.Size;
+
+			Ar.Logf(TEXT("  %10.2f KB  %-8s %s"), Entry.Size / 1024.0f, Entry.bIsNeeded ? TEXT("Needed") : TEXT("Unneeded"), *Entry.Path);
+			Ar.Logf(TEXT("      Settings: %s"), *Entry.Owners);
+			if (!Entry.Handles.IsEmpty())
+			{
+				Ar.Logf(TEXT("      Streamable handles: %s"), *Entry.Handles);
+			}
+			Ar.Logf(TEXT("      Referenced by: %s"), *Entry.Referencers);
+		}
+
+		Ar.Logf(TEXT("%d resident assets, %.2f MB, %.2f MB of it not needed by the current loading screen. %d referenced assets aren't resident."),
+			Entries.Num(), TotalSize / (1024.0f * 1024.0f), UnneededSize / (1024.0f * 1024.0f), NumNotResident);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		// Widget trees, brushes and decoded image files aren't assets, their memory is only known to the tracker
+		if (FLowLevelMemTracker::IsEnabled() && LLM_TAG_ASYNC_LOADING_SCREEN == ELLMTag::UI)
+		{
+			Ar.Logf(TEXT("The AsyncLoadingScreen LLM tag couldn't be registered, the plugin's allocations are part of the UI tag."));
+		}
+		else if (FLowLevelMemTracker::IsEnabled())
+		{
+			const int64 TrackedSize = FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, LLM_TAG_ASYNC_LOADING_SCREEN);
+			Ar.Logf(TEXT("%.2f MB allocated under the AsyncLoadingScreen LLM tag."), TrackedSize / (1024.0f * 1024.0f));
+		}
+#endif
+
+		const float BudgetMB = CVarMemReportBudget.GetValueOnGameThread();
+		if (BudgetMB > 0.0f && TotalSize > BudgetMB * 1024.0f * 1024.0f)
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("Resident loading screen assets take %.2f MB, over the %.2f MB budget."), TotalSize / (1024.0f * 1024.0f), BudgetMB);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice MemReportCommand(
+	TEXT("AsyncLoadingScreen.MemReport"),
+	TEXT("Lists the resident loading screen assets with their size, the settings and objects referencing them and whether the current loading screen needs them.\n")
+	TEXT("Totals over AsyncLoadingScreen.MemReport.BudgetMB are logged as errors."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&LoadingScreenMemoryReport::Run));
+
+#endif
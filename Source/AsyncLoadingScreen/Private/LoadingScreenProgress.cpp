@@ -0,0 +1,272 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenProgress.h"
+#include "AsyncLoadingScreen.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+#include "LoadingScreenTrace.h"
+#include "LoadingScreenLoadTimeModel.h"
+
+DECLARE_CYCLE_STAT(TEXT("Progress Sample"), STAT_ProgressSample, STATGROUP_AsyncLoadingScreen);
+
+namespace LoadingScreenProgress
+{
+	// Getting the percentage walks the async loading queue, there is no point in doing it more often than the bar can show it
+	const double SampleInterval = 1.0 / 30.0;
+
+	const int32 Unknown = -1;
+	const int32 Complete = 10000;
+
+	// The predicted progress of a phase eases out, it's 95% through the phase when its expected end is reached and only moves on when
+	// its milestone happens
+	const float PredictionSteepness = 3.0f;
+	const float MaxPredictedProgress = 0.99f;
+
+	// Phases of a load, each one but the last ends with a milestone of FLoadingScreenLoadMilestones
+	enum EPhase : int32
+	{
+		Setup,
+		LoadMap,
+		WaitForFirstFrame,
+		Finish,
+		Done,
+	};
+}
+
+FLoadingScreenProgress::FLoadingScreenProgress()
+	: Progress(LoadingScreenProgress::Unknown)
+	, PhaseState(0)
+	, StartCycles(FPlatformTime::Cycles64())
+{
+	for (TAtomic<int32>& MilestoneMs : ExpectedMilestonesMs)
+	{
+		MilestoneMs = LoadingScreenProgress::Unknown;
+	}
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FLoadingScreenProgress::OnPreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FLoadingScreenProgress::OnPostLoadMap);
+}
+
+FLoadingScreenProgress::~FLoadingScreenProgress()
+{
+	Stop();
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+}
+
+void FLoadingScreenProgress::Start()
+{
+	check(IsInGameThread());
+
+	Progress = LoadingScreenProgress::Unknown;
+	StartCycles = FPlatformTime::Cycles64();
+	bPackageSeen = false;
+	LastSampleTime = 0.0;
+
+	// The loading screen may be set up from PreLoadMap after the map load was seen
+	SetPhase(PackageName.IsNone() ? LoadingScreenProgress::Setup : LoadingScreenProgress::LoadMap);
+
+	if (!bIsSampling)
+	{
+		bIsSampling = true;
+		FlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddRaw(this, &FLoadingScreenProgress::OnAsyncLoadingFlushUpdate);
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLoadingScreenProgress::Tick));
+	}
+}
+
+void FLoadingScreenProgress::Stop()
+{
+	if (bIsSampling)
+	{
+		bIsSampling = false;
+		Progress = LoadingScreenProgress::Complete;
+		FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(FlushUpdateHandle);
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		SetPhase(LoadingScreenProgress::Done);
+	}
+
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	BeginFrameHandle.Reset();
+	PackageName = NAME_None;
+	for (TAtomic<int32>& MilestoneMs : ExpectedMilestonesMs)
+	{
+		MilestoneMs = LoadingScreenProgress::Unknown;
+	}
+}
+
+void FLoadingScreenProgress::SetExpectedMilestones(const FLoadingScreenLoadMilestones& Milestones)
+{
+	const float Seconds[] = { Milestones.PreLoadMapTime, Milestones.PostLoadMapTime, Milestones.FirstFrameTime, Milestones.Duration };
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Seconds); Index++)
+	{
+		const bool bIsKnown = Milestones.Duration > 0.0f && Seconds[Index] >= 0.0f;
+		ExpectedMilestonesMs[Index].Store(bIsKnown ? FMath::CeilToInt(Seconds[Index] * 1000.0f) : LoadingScreenProgress::Unknown, EMemoryOrder::Relaxed);
+	}
+}
+
+float FLoadingScreenProgress::GetProgress() const
+{
+	const int64 State = PhaseState.Load(EMemoryOrder::Relaxed);
+	const int32 Phase = static_cast<int32>(State >> 32);
+	if (Phase >= LoadingScreenProgress::Done)
+	{
+		return 1.0f;
+	}
+
+	const int32 Value = Progress.Load(EMemoryOrder::Relaxed);
+	const float MapProgress = Value < 0 ? -1.0f : Value / static_cast<float>(LoadingScreenProgress::Complete);
+
+	float Knots[LoadingScreenProgress::Done + 1];
+	if (!GetKnots(Knots))
+	{
+		return MapProgress;
+	}
+
+	// The engine percentage of the map package only covers the map load phase, it's jumpy and missing during blocking loads
+	const float Duration = Knots[LoadingScreenProgress::Done];
+	float Result = -1.0f;
+	if (Phase == LoadingScreenProgress::LoadMap && MapProgress >= 0.0f)
+	{
+		Result = FMath::Lerp(Knots[LoadingScreenProgress::LoadMap], Knots[LoadingScreenProgress::WaitForFirstFrame], MapProgress) / Duration;
+	}
+
+	// The prediction fills in between, from the start of the current phase towards its expected end
+	const float PhaseLength = FMath::Max(Knots[Phase + 1] - Knots[Phase], 0.001f);
+	const float PhaseTime = GetElapsedTime() - static_cast<uint32>(State) / 1000.0f;
+	const float Eased = 1.0f - FMath::Exp(-LoadingScreenProgress::PredictionSteepness * FMath::Max(PhaseTime, 0.0f) / PhaseLength);
+	const float Predicted = (Knots[Phase] + PhaseLength * Eased) / Duration;
+
+	return FMath::Max(Result, FMath::Min(Predicted, LoadingScreenProgress::MaxPredictedProgress));
+}
+
+float FLoadingScreenProgress::GetRemainingTime() const
+{
+	const int64 State = PhaseState.Load(EMemoryOrder::Relaxed);
+	const int32 Phase = static_cast<int32>(State >> 32);
+
+	float Knots[LoadingScreenProgress::Done + 1];
+	if (Phase >= LoadingScreenProgress::Done || !GetKnots(Knots))
+	{
+		return -1.0f;
+	}
+
+	// What's left of the current phase, then the expected length of the next ones
+	const float PhaseTime = GetElapsedTime() - static_cast<uint32>(State) / 1000.0f;
+	return FMath::Max(Knots[Phase + 1] - Knots[Phase] - PhaseTime, 0.0f) + Knots[LoadingScreenProgress::Done] - Knots[Phase + 1];
+}
+
+bool FLoadingScreenProgress::GetKnots(float* OutKnots) const
+{
+	const int32 DurationMs = ExpectedMilestonesMs[UE_ARRAY_COUNT(ExpectedMilestonesMs) - 1].Load(EMemoryOrder::Relaxed);
+	if (DurationMs <= 0)
+	{
+		return false;
+	}
+
+	// The milestones may be written while they're read, keep the knots in order whatever mix is read
+	OutKnots[LoadingScreenProgress::Setup] = 0.0f;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(ExpectedMilestonesMs); Index++)
+	{
+		const int32 MilestoneMs = ExpectedMilestonesMs[Index].Load(EMemoryOrder::Relaxed);
+		OutKnots[Index + 1] = FMath::Clamp(MilestoneMs >= 0 ? MilestoneMs : DurationMs, 0, DurationMs) / 1000.0f;
+		OutKnots[Index + 1] = FMath::Max(OutKnots[Index + 1], OutKnots[Index]);
+	}
+	OutKnots[LoadingScreenProgress::Done] = DurationMs / 1000.0f;
+	return true;
+}
+
+void FLoadingScreenProgress::SetPhase(int32 Phase)
+{
+	const uint32 StartMs = static_cast<uint32>(FMath::Max(FMath::FloorToInt(GetElapsedTime() * 1000.0f), 0));
+	PhaseState.Store((static_cast<int64>(Phase) << 32) | StartMs, EMemoryOrder::Relaxed);
+}
+
+float FLoadingScreenProgress::GetElapsedTime() const
+{
+	return static_cast<float>(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles.Load(EMemoryOrder::Relaxed)));
+}
+
+void FLoadingScreenProgress::OnPreLoadMap(const FString& MapName)
+{
+	PackageName = FName(*MapName);
+	bPackageSeen = false;
+
+	if (bIsSampling)
+	{
+		SetPhase(LoadingScreenProgress::LoadMap);
+	}
+}
+
+void FLoadingScreenProgress::OnPostLoadMap(UWorld* World)
+{
+	if (bIsSampling)
+	{
+		SetPhase(LoadingScreenProgress::WaitForFirstFrame);
+
+		// The world ticks its first frame on the next engine frame
+		if (!BeginFrameHandle.IsValid())
+		{
+			BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FLoadingScreenProgress::OnBeginFrame);
+		}
+	}
+}
+
+void FLoadingScreenProgress::OnBeginFrame()
+{
+	if (bIsSampling)
+	{
+		SetPhase(LoadingScreenProgress::Finish);
+	}
+
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	BeginFrameHandle.Reset();
+}
+
+void FLoadingScreenProgress::OnAsyncLoadingFlushUpdate()
+{
+	Sample();
+}
+
+bool FLoadingScreenProgress::Tick(float DeltaTime)
+{
+	Sample();
+	return true;
+}
+
+void FLoadingScreenProgress::Sample()
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (PackageName.IsNone() || CurrentTime - LastSampleTime < LoadingScreenProgress::SampleInterval)
+	{
+		return;
+	}
+
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_ProgressSample);
+	LastSampleTime = CurrentTime;
+
+	int32 NewProgress = LoadingScreenProgress::Unknown;
+	const float Percentage = GetAsyncLoadPercentage(PackageName);
+	if (Percentage >= 0.0f)
+	{
+		bPackageSeen = true;
+		NewProgress = FMath::Clamp(FMath::RoundToInt(Percentage * 100.0f), 0, LoadingScreenProgress::Complete);
+	}
+	else if (bPackageSeen)
+	{
+		// The package leaves the async loading queue once it's loaded
+		NewProgress = LoadingScreenProgress::Complete;
+	}
+
+	// Only the game thread writes, the bar never goes backwards
+	if (NewProgress > Progress.Load(EMemoryOrder::Relaxed))
+	{
+		Progress.Store(NewProgress, EMemoryOrder::Relaxed);
+	}
+}
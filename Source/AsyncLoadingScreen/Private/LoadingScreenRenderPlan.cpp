@@ -0,0 +1,85 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenRenderPlan.h"
+#include "Slate/DeferredCleanupSlateBrush.h"
+
+FLoadingScreenRenderPlanRef FLoadingScreenRenderPlan::Create(const FALoadingScreenSettings& InSettings, const ULoadingScreenSettings& InLayoutSettings)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FLoadingScreenRenderPlan, ESPMode::ThreadSafe> Plan = MakeShareable(new FLoadingScreenRenderPlan());
+	Plan->Settings = InSettings;
+	Plan->Classic = InLayoutSettings.Classic;
+	Plan->Center = InLayoutSettings.Center;
+	Plan->Letterbox = InLayoutSettings.Letterbox;
+	Plan->Sidebar = InLayoutSettings.Sidebar;
+	Plan->DualSidebar = InLayoutSettings.DualSidebar;
+	Plan->TextureLimits = FLoadingScreenTextureLimits(InLayoutSettings);
+
+	if (Plan->Settings.bShowWidgetOverlay)
+	{
+		const FLoadingWidgetSettings& LoadingWidget = Plan->Settings.LoadingWidget;
+		switch (LoadingWidget.LoadingIconType)
+		{
+		case ELoadingIconType::LIT_Throbber:
+			Plan->ReferenceBrushResource(LoadingWidget.ThrobberSettings.Image);
+			break;
+		case ELoadingIconType::LIT_CircularThrobber:
+			Plan->ReferenceBrushResource(LoadingWidget.CircularThrobberSettings.Image);
+			break;
+		case ELoadingIconType::LIT_BatchedThrobber:
+			Plan->ReferenceBrushResource(LoadingWidget.BatchedThrobberSettings.Image);
+			break;
+		default:
+			// Image sequences are streamed in and referenced by the loading widget
+			break;
+		}
+
+		if (LoadingWidget.bShowProgressBar)
+		{
+			const FProgressBarStyle& ProgressBarStyle = LoadingWidget.ProgressBarSettings.Style;
+			Plan->ReferenceBrushResource(ProgressBarStyle.BackgroundImage);
+			Plan->ReferenceBrushResource(ProgressBarStyle.FillImage);
+			Plan->ReferenceBrushResource(ProgressBarStyle.MarqueeImage);
+		}
+
+		switch (Plan->Settings.Layout)
+		{
+		case EAsyncLoadingScreenLayout::ALSL_Center:
+			Plan->ReferenceBrushResource(Plan->Center.BorderBackground);
+			break;
+		case EAsyncLoadingScreenLayout::ALSL_Letterbox:
+			Plan->ReferenceBrushResource(Plan->Letterbox.TopBorderBackground);
+			Plan->ReferenceBrushResource(Plan->Letterbox.BottomBorderBackground);
+			break;
+		case EAsyncLoadingScreenLayout::ALSL_Sidebar:
+			Plan->ReferenceBrushResource(Plan->Sidebar.BorderBackground);
+			break;
+		case EAsyncLoadingScreenLayout::ALSL_DualSidebar:
+			Plan->ReferenceBrushResource(Plan->DualSidebar.LeftBorderBackground);
+			Plan->ReferenceBrushResource(Plan->DualSidebar.RightBorderBackground);
+			break;
+		case EAsyncLoadingScreenLayout::ALSL_Classic:
+		default:
+			Plan->ReferenceBrushResource(Plan->Classic.BorderBackground);
+			break;
+		}
+	}
+
+	return Plan;
+}
+
+void FLoadingScreenRenderPlan::ReferenceBrushResource(const FSlateBrush& Brush)
+{
+	if (Brush.GetResourceObject() != nullptr)
+	{
+		BrushResourceReferences.Add(FDeferredCleanupSlateBrush::CreateBrush(Brush));
+		BrushCounter.Set(BrushResourceReferences.Num());
+	}
+}
@@ -0,0 +1,105 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenSourceFrames.h"
+
+#if WITH_EDITOR
+#include "Engine/Texture2D.h"
+#include "AssetRegistryModule.h"
+#include "AsyncLoadingScreen.h"
+
+namespace
+{
+	/** Returns the number at the end of the asset name, e.g. 12 for "Mannequin_Run-12", so frames sort naturally */
+	int32 GetFrameNumber(const FString& AssetName)
+	{
+		int32 NumberStart = AssetName.Len();
+		while (NumberStart > 0 && FChar::IsDigit(AssetName[NumberStart - 1]))
+		{
+			NumberStart--;
+		}
+		return NumberStart < AssetName.Len() ? FCString::Atoi(*AssetName.Mid(NumberStart)) : 0;
+	}
+}
+
+void FLoadingScreenSourceFrames::Gather(const TArray<TSoftObjectPtr<UTexture2D>>& SourceFrames, const FDirectoryPath& SourceFolder, TArray<UTexture2D*>& OutFrames)
+{
+	if (SourceFrames.Num() > 0)
+	{
+		for (const TSoftObjectPtr<UTexture2D>& SourceFrame : SourceFrames)
+		{
+			if (UTexture2D* Frame = SourceFrame.LoadSynchronous())
+			{
+				OutFrames.Add(Frame);
+			}
+		}
+	}
+	else if (!SourceFolder.Path.IsEmpty())
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		FARFilter Filter;
+		Filter.PackagePaths.Add(FName(*SourceFolder.Path));
+		Filter.ClassNames.Add(UTexture2D::StaticClass()->GetFName());
+
+		TArray<FAssetData> AssetDataList;
+		AssetRegistry.GetAssets(Filter, AssetDataList);
+		AssetDataList.Sort([](const FAssetData& A, const FAssetData& B)
+		{
+			const FString NameA = A.AssetName.ToString();
+			const FString NameB = B.AssetName.ToString();
+			const int32 NumberA = GetFrameNumber(NameA);
+			const int32 NumberB = GetFrameNumber(NameB);
+			return NumberA != NumberB ? NumberA < NumberB : NameA < NameB;
+		});
+
+		for (const FAssetData& AssetData : AssetDataList)
+		{
+			if (UTexture2D* Frame = Cast<UTexture2D>(AssetData.GetAsset()))
+			{
+				OutFrames.Add(Frame);
+			}
+		}
+	}
+}
+
+bool FLoadingScreenSourceFrames::ReadPixels(UTexture2D* Frame, const FIntPoint& ExpectedSize, TArray64<uint8>& OutPixels)
+{
+	const FTextureSource& Source = Frame->Source;
+	if (Source.GetSizeX() != ExpectedSize.X || Source.GetSizeY() != ExpectedSize.Y)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Skipping frame %s, its size doesn't match the first frame."), *Frame->GetName());
+		return false;
+	}
+
+	const ETextureSourceFormat Format = Source.GetFormat();
+	TArray64<uint8> MipData;
+	if ((Format != TSF_BGRA8 && Format != TSF_G8) || !Frame->Source.GetMipData(MipData, 0))
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Skipping frame %s, only BGRA8 and G8 source images are supported."), *Frame->GetName());
+		return false;
+	}
+
+	if (Format == TSF_BGRA8)
+	{
+		OutPixels = MoveTemp(MipData);
+	}
+	else
+	{
+		const int64 NumPixels = static_cast<int64>(ExpectedSize.X) * ExpectedSize.Y;
+		OutPixels.SetNumUninitialized(NumPixels * 4);
+		for (int64 Index = 0; Index < NumPixels; ++Index)
+		{
+			OutPixels[Index * 4 + 0] = OutPixels[Index * 4 + 1] = OutPixels[Index * 4 + 2] = MipData[Index];
+			OutPixels[Index * 4 + 3] = 255;
+		}
+	}
+
+	return true;
+}
+#endif
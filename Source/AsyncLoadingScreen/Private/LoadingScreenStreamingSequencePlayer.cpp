@@ -0,0 +1,179 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenStreamingSequencePlayer.h"
+#include "LoadingScreenAnimatedImage.h"
+#include "AsyncLoadingScreen.h"
+#include "Engine/Texture2D.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "LoadingScreenTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Decode Streaming Sequence Frame"), STAT_DecodeStreamingSequenceFrame, STATGROUP_AsyncLoadingScreen);
+
+FLoadingScreenStreamingSequencePlayer::FLoadingScreenStreamingSequencePlayer(IImageWrapperModule& InImageWrapperModule, const FString& InFilePath, UTexture2D* InTexture, int32 InBufferSize)
+	: ImageWrapperModule(InImageWrapperModule)
+	, FilePath(InFilePath)
+	, Texture(InTexture)
+{
+	check(Texture);
+	RingBuffer.SetNum(FMath::Max(1, InBufferSize));
+}
+
+void FLoadingScreenStreamingSequencePlayer::Start()
+{
+	KickDecoder();
+}
+
+bool FLoadingScreenStreamingSequencePlayer::Tick(float DeltaTime)
+{
+	if (bIsStopped)
+	{
+		return false;
+	}
+
+	CurrentFrameTime += DeltaTime;
+	if (CurrentFrameTime < CurrentFrameDuration)
+	{
+		return false;
+	}
+
+	FBufferedFrame Frame;
+	{
+		FScopeLock Lock(&RingBufferCS);
+		if (NumBufferedFrames == 0)
+		{
+			// The decoder fell behind, keep showing the current frame
+			KickDecoder();
+			return false;
+		}
+
+		Frame = MoveTemp(RingBuffer[ReadIndex]);
+		ReadIndex = (ReadIndex + 1) % RingBuffer.Num();
+		NumBufferedFrames--;
+	}
+
+	KickDecoder();
+
+	// Carry the overshoot over to the next frame without letting it skip frames
+	CurrentFrameTime = CurrentFrameDuration > 0.0f ? FMath::Min(CurrentFrameTime - CurrentFrameDuration, Frame.Duration) : 0.0f;
+	CurrentFrameDuration = Frame.Duration;
+
+	UploadFrame(MoveTemp(Frame.Pixels));
+	return true;
+}
+
+void FLoadingScreenStreamingSequencePlayer::Stop()
+{
+	bIsStopped = true;
+
+	// Wait for the frame in flight
+	FScopeLock Lock(&DecodeCS);
+}
+
+int64 FLoadingScreenStreamingSequencePlayer::GetAllocatedSize() const
+{
+	int64 AllocatedSize = DecoderAllocatedSize;
+
+	FScopeLock Lock(&RingBufferCS);
+	for (const FBufferedFrame& Frame : RingBuffer)
+	{
+		AllocatedSize += Frame.Pixels.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
+
+void FLoadingScreenStreamingSequencePlayer::KickDecoder()
+{
+	if (bIsStopped || bHasFailed)
+	{
+		return;
+	}
+
+	if (!bIsDecoding.Exchange(true))
+	{
+		TSharedRef<FLoadingScreenStreamingSequencePlayer, ESPMode::ThreadSafe> Player = AsShared();
+		Async(EAsyncExecution::ThreadPool, [Player]()
+		{
+			Player->DecodeFrames();
+		});
+	}
+}
+
+void FLoadingScreenStreamingSequencePlayer::DecodeFrames()
+{
+	{
+		FScopeLock DecodeLock(&DecodeCS);
+
+		if (!Image.IsValid() && !bIsStopped)
+		{
+			Image = FLoadingScreenAnimatedImage::Open(ImageWrapperModule, FilePath);
+			if (!Image.IsValid() || Image->GetSize() != FIntPoint(Texture->GetSizeX(), Texture->GetSizeY()))
+			{
+				UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Can't stream animated image %s."), *FilePath);
+				Image.Reset();
+				bHasFailed = true;
+			}
+			else
+			{
+				UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Streaming animated image %s: %d frames, %d frames buffered ahead."), *FilePath, Image->GetNumFrames(), RingBuffer.Num());
+			}
+		}
+
+		while (Image.IsValid() && !bIsStopped)
+		{
+			{
+				FScopeLock Lock(&RingBufferCS);
+				if (NumBufferedFrames >= RingBuffer.Num())
+				{
+					break;
+				}
+			}
+
+			FBufferedFrame Frame;
+			{
+				SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_DecodeStreamingSequenceFrame);
+				LLM_SCOPE_LOADING_SCREEN();
+				if (!Image->DecodeNextFrame(Frame.Pixels, Frame.Duration))
+				{
+					UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to decode a frame of animated image %s."), *FilePath);
+					bHasFailed = true;
+					break;
+				}
+			}
+
+			DecoderAllocatedSize = Image->GetAllocatedSize();
+
+			FScopeLock Lock(&RingBufferCS);
+			RingBuffer[(ReadIndex + NumBufferedFrames) % RingBuffer.Num()] = MoveTemp(Frame);
+			NumBufferedFrames++;
+		}
+	}
+
+	bIsDecoding = false;
+}
+
+void FLoadingScreenStreamingSequencePlayer::UploadFrame(TArray<uint8>&& Pixels)
+{
+	const int32 SizeX = Texture->GetSizeX();
+	const int32 SizeY = Texture->GetSizeY();
+	if (Pixels.Num() != SizeX * SizeY * 4)
+	{
+		return;
+	}
+
+	// Hand the pixels over to the render thread, they're freed once uploaded
+	TArray<uint8>* FramePixels = new TArray<uint8>(MoveTemp(Pixels));
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, SizeX, SizeY);
+	Texture->UpdateTextureRegions(0, 1, Region, SizeX * 4, 4, FramePixels->GetData(), [FramePixels](uint8* SrcData, const FUpdateTextureRegion2D* SrcRegions)
+	{
+		delete FramePixels;
+		delete SrcRegions;
+	});
+}
@@ -0,0 +1,226 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenTextPrewarmer.h"
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenSettings.h"
+#include "LoadingScreenTextureStreaming.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontCache.h"
+#include "Rendering/SlateRenderer.h"
+#include "Internationalization/Culture.h"
+#include "MoviePlayer.h"
+#include "LoadingScreenTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Text Prewarm"), STAT_TextPrewarm, STATGROUP_AsyncLoadingScreen);
+
+namespace LoadingScreenTextPrewarmer
+{
+	// Time the prewarm may take on each game thread tick, in seconds
+	const double TimeBudgetPerTick = 0.002;
+}
+
+FLoadingScreenTextPrewarmer::~FLoadingScreenTextPrewarmer()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+void FLoadingScreenTextPrewarmer::Queue(const FALoadingScreenSettings& Settings)
+{
+	check(IsInGameThread());
+
+	if (!CanPrewarm(Settings))
+	{
+		return;
+	}
+
+	// Glyphs are cached per font size on screen, so the texts have to be shaped at the scale they'll be painted at
+	const float DPIScale = FLoadingScreenTextureStreaming::GetViewportDPIScale();
+
+	for (const FText& TipText : Settings.TipWidget.TipText)
+	{
+		QueueText(TipText, Settings.TipWidget.Appearance.Font, DPIScale);
+	}
+
+	QueueText(Settings.LoadingWidget.LoadingText, Settings.LoadingWidget.Appearance.Font, GetLoadingTextScale(Settings, DPIScale));
+
+	if (NextQueuedText < QueuedTexts.Num() && !TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FLoadingScreenTextPrewarmer::Tick));
+	}
+}
+
+void FLoadingScreenTextPrewarmer::Flush()
+{
+	check(IsInGameThread());
+
+	if (NextQueuedText < QueuedTexts.Num())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Prewarming %d texts left before the loading screen shows up."), QueuedTexts.Num() - NextQueuedText);
+	}
+
+	while (NextQueuedText < QueuedTexts.Num())
+	{
+		PrewarmNext();
+	}
+
+	OnQueueDone();
+}
+
+void FLoadingScreenTextPrewarmer::Flush(const FALoadingScreenSettings& Settings, int32 TipTextIndex)
+{
+	check(IsInGameThread());
+
+	Queue(Settings);
+	if (NextQueuedText >= QueuedTexts.Num())
+	{
+		return;
+	}
+
+	// Only the texts the first frame shows, the other tips stay queued for the ticks after the loading screen
+	const float DPIScale = FLoadingScreenTextureStreaming::GetViewportDPIScale();
+	TArray<uint32, TInlineAllocator<2>> TextKeys;
+	if (Settings.TipWidget.TipText.IsValidIndex(TipTextIndex))
+	{
+		TextKeys.Add(GetTextKey(Settings.TipWidget.TipText[TipTextIndex].ToString(), Settings.TipWidget.Appearance.Font, DPIScale));
+	}
+	TextKeys.Add(GetTextKey(Settings.LoadingWidget.LoadingText.ToString(), Settings.LoadingWidget.Appearance.Font, GetLoadingTextScale(Settings, DPIScale)));
+
+	int32 NumFlushed = 0;
+	for (int32 Index = NextQueuedText; Index < QueuedTexts.Num(); ++Index)
+	{
+		if (TextKeys.Contains(QueuedTexts[Index].Key))
+		{
+			// Move it to the front of what's left, everything in between has already been checked
+			QueuedTexts.Swap(Index, NextQueuedText);
+			PrewarmNext();
+			NumFlushed++;
+		}
+	}
+
+	if (NumFlushed > 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Prewarmed %d texts before the loading screen shows up, %d left queued."), NumFlushed, QueuedTexts.Num() - NextQueuedText);
+	}
+
+	if (NextQueuedText >= QueuedTexts.Num())
+	{
+		OnQueueDone();
+	}
+}
+
+bool FLoadingScreenTextPrewarmer::Tick(float DeltaTime)
+{
+	// The loading thread owns the font cache while the loading screen is shown
+	if (GetMoviePlayer()->IsMovieCurrentlyPlaying())
+	{
+		return true;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (NextQueuedText < QueuedTexts.Num() && FPlatformTime::Seconds() - StartTime < LoadingScreenTextPrewarmer::TimeBudgetPerTick)
+	{
+		PrewarmNext();
+	}
+
+	if (NextQueuedText < QueuedTexts.Num())
+	{
+		return true;
+	}
+
+	// Returning false removes the ticker
+	TickerHandle.Reset();
+	OnQueueDone();
+	return false;
+}
+
+void FLoadingScreenTextPrewarmer::PrewarmNext()
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_TextPrewarm);
+	LLM_SCOPE_LOADING_SCREEN();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const FQueuedText& QueuedText = QueuedTexts[NextQueuedText++];
+	const TSharedRef<FSlateFontCache> FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+
+	// Shaping loads the font faces, getting the atlas data of a glyph rasterizes it if it isn't in the atlas yet
+	const FShapedGlyphSequenceRef ShapedText = FontCache->ShapeBidirectionalText(QueuedText.Text, QueuedText.Font, QueuedText.FontScale,
+		TextBiDi::ComputeBaseDirection(QueuedText.Text), GetDefaultTextShapingMethod());
+
+	for (const FShapedGlyphEntry& Glyph : ShapedText->GetGlyphsToRender())
+	{
+		if (Glyph.bIsVisible)
+		{
+			FontCache->GetShapedGlyphFontAtlasData(Glyph, QueuedText.Font.OutlineSettings);
+			NumPrewarmedGlyphs++;
+		}
+	}
+
+	PrewarmCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void FLoadingScreenTextPrewarmer::QueueText(const FText& Text, const FSlateFontInfo& Font, float FontScale)
+{
+	if (Text.IsEmpty() || !Font.HasValidFont())
+	{
+		return;
+	}
+
+	const FString& String = Text.ToString();
+	const uint32 Key = GetTextKey(String, Font, FontScale);
+
+	bool bAlreadyPrewarmed = false;
+	PrewarmedTexts.Add(Key, &bAlreadyPrewarmed);
+	if (!bAlreadyPrewarmed)
+	{
+		QueuedTexts.Add({ String, Font, FontScale, Key });
+	}
+}
+
+bool FLoadingScreenTextPrewarmer::CanPrewarm(const FALoadingScreenSettings& Settings)
+{
+	return Settings.bShowWidgetOverlay && FSlateApplication::IsInitialized() && FSlateApplication::Get().GetRenderer() != nullptr;
+}
+
+float FLoadingScreenTextPrewarmer::GetLoadingTextScale(const FALoadingScreenSettings& Settings, float DPIScale)
+{
+	// The center layout doesn't scale the loading widget
+	return Settings.Layout == EAsyncLoadingScreenLayout::ALSL_Center ? 1.0f : DPIScale;
+}
+
+uint32 FLoadingScreenTextPrewarmer::GetTextKey(const FString& Text, const FSlateFontInfo& Font, float FontScale)
+{
+	// The texts are localized, the same settings need prewarming again when the culture changes
+	uint32 Key = GetTypeHash(FInternationalization::Get().GetCurrentCulture()->GetName());
+	Key = HashCombine(Key, GetTypeHash(Text));
+	Key = HashCombine(Key, GetTypeHash(Font));
+	Key = HashCombine(Key, GetTypeHash(FontScale));
+	return Key;
+}
+
+void FLoadingScreenTextPrewarmer::OnQueueDone()
+{
+	if (QueuedTexts.Num() > 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Prewarmed %d texts, %d glyphs in %.3f ms."), QueuedTexts.Num(), NumPrewarmedGlyphs, FPlatformTime::ToMilliseconds64(PrewarmCycles));
+	}
+
+	QueuedTexts.Reset();
+	NextQueuedText = 0;
+	NumPrewarmedGlyphs = 0;
+	PrewarmCycles = 0;
+
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
@@ -0,0 +1,164 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "LoadingScreenTextureStreaming.h"
+#include "LoadingScreenSettings.h"
+#include "AsyncLoadingScreen.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/Texture2D.h"
+#include "Engine/UserInterfaceSettings.h"
+#include "Framework/Application/SlateApplication.h"
+#include "ContentStreaming.h"
+
+namespace LoadingScreenTextureStreaming
+{
+	/** LOD bias of a texture before the loading screen limited it */
+	struct FLimitedTexture
+	{
+		int32 LODBias;
+		int32 CachedLODBias;
+	};
+
+	// Textures limited by the current loading screen, only touched on the game thread
+	TMap<TWeakObjectPtr<UTexture2D>, FLimitedTexture> LimitedTextures;
+}
+
+FLoadingScreenTextureLimits::FLoadingScreenTextureLimits(const ULoadingScreenSettings& Settings)
+	: bLimitToScreenSize(Settings.bLimitTextureMipsToScreenSize)
+	, MaxResolution(Settings.MaxResidentTextureResolution)
+{
+}
+
+FVector2D FLoadingScreenTextureStreaming::GetViewportSize()
+{
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+	if (GEngine && GEngine->GameViewport)
+	{
+		GEngine->GameViewport->GetViewportSize(ViewportSize);
+	}
+
+	if (ViewportSize.IsNearlyZero() && FSlateApplication::IsInitialized())
+	{
+		FDisplayMetrics DisplayMetrics;
+		FSlateApplication::Get().GetCachedDisplayMetrics(DisplayMetrics);
+		ViewportSize = FVector2D(DisplayMetrics.PrimaryDisplayWidth, DisplayMetrics.PrimaryDisplayHeight);
+	}
+
+	return ViewportSize;
+}
+
+float FLoadingScreenTextureStreaming::GetStretchScale(EStretch::Type Stretch, const FVector2D& TextureSize, const FVector2D& AreaSize)
+{
+	if (TextureSize.X <= 0.0f || TextureSize.Y <= 0.0f || AreaSize.IsNearlyZero())
+	{
+		return 1.0f;
+	}
+
+	const float ScaleX = AreaSize.X / TextureSize.X;
+	const float ScaleY = AreaSize.Y / TextureSize.Y;
+
+	switch (Stretch)
+	{
+	case EStretch::ScaleToFit:
+		return FMath::Min(ScaleX, ScaleY);
+	case EStretch::ScaleToFitX:
+		return ScaleX;
+	case EStretch::ScaleToFitY:
+		return ScaleY;
+	case EStretch::ScaleToFill:
+	case EStretch::Fill:
+		return FMath::Max(ScaleX, ScaleY);
+	case EStretch::ScaleBySafeZone:
+	case EStretch::UserSpecified:
+	case EStretch::None:
+	default:
+		return 1.0f;
+	}
+}
+
+float FLoadingScreenTextureStreaming::GetViewportDPIScale()
+{
+	const FVector2D ViewportSize = GetViewportSize();
+	return GetDefault<UUserInterfaceSettings>()->GetDPIScaleBasedOnSize(FIntPoint(ViewportSize.X, ViewportSize.Y));
+}
+
+void FLoadingScreenTextureStreaming::UpdateResidentMips(UTexture2D* Texture, float ScreenScale, const FLoadingScreenTextureLimits& Limits)
+{
+	check(IsInGameThread());
+
+	if (Texture == nullptr || !Limits.bLimitToScreenSize)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	// LODBias is a serialized property, in the editor the changed bias would be saved with the texture if anything dirtied it
+	if (GIsEditor)
+	{
+		return;
+	}
+#endif
+
+	if (!Texture->IsStreamable())
+	{
+		UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("%s can't be streamed, all of its mips stay resident."), *Texture->GetName());
+		return;
+	}
+
+	const int32 NumMips = Texture->GetNumMips();
+	const int32 TopMipSize = FMath::Max(Texture->GetSizeX(), Texture->GetSizeY());
+
+	// Every halving of the on-screen scale makes one more mip invisible
+	int32 MipsToDrop = ScreenScale > 0.0f && ScreenScale < 1.0f ? FMath::FloorToInt(FMath::Log2(1.0f / ScreenScale)) : 0;
+
+	// Cap the largest resident mip
+	if (Limits.MaxResolution > 0)
+	{
+		while (MipsToDrop < NumMips - 1 && (TopMipSize >> MipsToDrop) > Limits.MaxResolution)
+		{
+			MipsToDrop++;
+		}
+	}
+
+	MipsToDrop = FMath::Clamp(MipsToDrop, 0, NumMips - Texture->GetNumNonStreamingMips());
+
+	// The bias of the texture LOD group and the texture itself may already drop as many mips
+	const LoadingScreenTextureStreaming::FLimitedTexture& Limited = LoadingScreenTextureStreaming::LimitedTextures.FindOrAdd(Texture,
+		LoadingScreenTextureStreaming::FLimitedTexture{ Texture->LODBias, Texture->GetCachedLODBias() });
+	const int32 LODBias = Limited.LODBias + FMath::Max(MipsToDrop - Limited.CachedLODBias, 0);
+	if (Texture->LODBias == LODBias)
+	{
+		return;
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Verbose, TEXT("%s: %d of %d mips wanted at screen scale %.3f, LOD bias %d."), *Texture->GetName(), NumMips - MipsToDrop, NumMips, ScreenScale, LODBias);
+
+	Texture->LODBias = LODBias;
+	Texture->UpdateCachedLODBias();
+	if (IStreamingManager::Get().IsTextureStreamingEnabled())
+	{
+		IStreamingManager::Get().GetRenderAssetStreamingManager().UpdateIndividualRenderAsset(Texture);
+	}
+}
+
+void FLoadingScreenTextureStreaming::RestoreResidentMips()
+{
+	check(IsInGameThread());
+
+	for (const TPair<TWeakObjectPtr<UTexture2D>, LoadingScreenTextureStreaming::FLimitedTexture>& Limited : LoadingScreenTextureStreaming::LimitedTextures)
+	{
+		if (UTexture2D* Texture = Limited.Key.Get())
+		{
+			Texture->LODBias = Limited.Value.LODBias;
+			Texture->UpdateCachedLODBias();
+		}
+	}
+
+	LoadingScreenTextureStreaming::LimitedTextures.Reset();
+}
@@ -8,49 +8,94 @@
 
 #include "SBackgroundWidget.h"
 #include "LoadingScreenSettings.h"
-#include "Slate/DeferredCleanupSlateBrush.h"
+#include "LoadingScreenBackgroundLoader.h"
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Layout/SBorder.h"
-#include "Engine/Texture2D.h"
-#include "AsyncLoadingScreenLibrary.h"
+#include "Widgets/Layout/SScaleBox.h"
+
+DECLARE_CYCLE_STAT(TEXT("Background Construct"), STAT_BackgroundConstruct, STATGROUP_AsyncLoadingScreen);
+
+SBackgroundWidget::~SBackgroundWidget()
+{
+	ReleaseImage();
+}
 
 void SBackgroundWidget::Construct(const FArguments& InArgs, const FBackgroundSettings& Settings)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_BackgroundConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	BackgroundLoader = MakeShared<FLoadingScreenBackgroundLoader, ESPMode::ThreadSafe>(Settings, InArgs._TextureLimits);
+
 	// If there's an image defined
-	if (Settings.Images.Num() > 0)
+	if (BackgroundLoader->GetNumImages() > 0)
 	{
-		int32 ImageIndex = FMath::RandRange(0, Settings.Images.Num() - 1);
-
-		if (Settings.bSetDisplayBackgroundManually == true)
-		{
-			if (Settings.Images.IsValidIndex(UAsyncLoadingScreenLibrary::GetDisplayBackgroundIndex()))
-			{
-				ImageIndex = UAsyncLoadingScreenLibrary::GetDisplayBackgroundIndex();
-			}
-		}
-
-		const FSoftObjectPath& ImageAsset = Settings.Images[ImageIndex];
-		UObject* ImageObject = ImageAsset.TryLoad();
-		if (UTexture2D* LoadingImage = Cast<UTexture2D>(ImageObject))
-		{
-			ImageBrush = FDeferredCleanupSlateBrush::CreateBrush(LoadingImage);
-			ChildSlot
+		// Show the border with background color right away, the image will be swapped in when it's loaded
+		ChildSlot
+		[
+			SNew(SBorder)
+			.HAlign(HAlign_Fill)
+			.VAlign(VAlign_Fill)
+			.Padding(Settings.Padding)
+			.BorderBackgroundColor(Settings.BackgroundColor)
+			.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
 			[
-				SNew(SBorder)
-				.HAlign(HAlign_Fill)
-				.VAlign(VAlign_Fill)
-				.Padding(Settings.Padding)
-				.BorderBackgroundColor(Settings.BackgroundColor)
-				.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+				SNew(SScaleBox)
+				.Stretch(Settings.ImageStretch)
 				[
-					SNew(SScaleBox)
-					.Stretch(Settings.ImageStretch)
-					[
-						SNew(SImage)						
-						.Image(ImageBrush.IsValid() ? ImageBrush->GetSlateBrush() : nullptr)						
-					]
+					SAssignNew(Image, SImage)
+					.Image(nullptr)
 				]
-			];			
-		}
+			]
+		];
+
+		RequestBackgroundImage();
+	}
+}
+
+void SBackgroundWidget::Rebind()
+{
+	if (BackgroundLoader->GetNumImages() > 0)
+	{
+		ReleaseImage();
+		RequestBackgroundImage();
+	}
+}
+
+void SBackgroundWidget::ReleaseImage()
+{
+	// Stop showing the brush before the loader lets go of it
+	if (BackgroundLoader->GetBrush() != nullptr)
+	{
+		Image->SetImage(nullptr);
+	}
+	BackgroundLoader->Release();
+}
+
+void SBackgroundWidget::RequestBackgroundImage()
+{
+	BackgroundLoader->Request();
+
+	if (!bIsActiveTimerRegistered)
+	{
+		bIsActiveTimerRegistered = true;
+		RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SBackgroundWidget::UpdateBackgroundImage));
+	}
+}
+
+EActiveTimerReturnType SBackgroundWidget::UpdateBackgroundImage(double InCurrentTime, float InDeltaTime)
+{
+	if (BackgroundLoader->Update())
+	{
+		Image->SetImage(BackgroundLoader->GetBrush());
 	}
+
+	// Keep waiting until the request is done, stop if it failed
+	if (BackgroundLoader->IsRequestDone())
+	{
+		bIsActiveTimerRegistered = false;
+		return EActiveTimerReturnType::Stop;
+	}
+
+	return EActiveTimerReturnType::Continue;
 }
@@ -0,0 +1,178 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "SBatchedThrobber.h"
+#include "AsyncLoadingScreen.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Throbber Paint"), STAT_BatchedThrobberPaint, STATGROUP_AsyncLoadingScreen);
+
+void FBatchedThrobberGeometry::Initialize(const FBatchedThrobberSettings& InSettings)
+{
+	Settings = InSettings;
+	NumPieces = FMath::Max(Settings.NumberOfPieces, 0);
+
+	const int32 NumPadded = Align(NumPieces, 4);
+	BaseCos.SetNumZeroed(NumPadded);
+	BaseSin.SetNumZeroed(NumPadded);
+	PieceScales.SetNumZeroed(NumPadded);
+	PieceOpacities.SetNumZeroed(NumPadded);
+	CenterX.SetNumZeroed(NumPadded);
+	CenterY.SetNumZeroed(NumPadded);
+	HalfWidth.SetNumZeroed(NumPadded);
+	HalfHeight.SetNumZeroed(NumPadded);
+
+	// Same as SCircularThrobber, the pieces go around the circle and grow or fade in until the last one
+	const float DeltaAngle = NumPieces > 0 ? 2.0f * PI / NumPieces : 0.0f;
+	for (int32 PieceIndex = 0; PieceIndex < NumPieces; PieceIndex++)
+	{
+		const float Trail = (PieceIndex + 1) / static_cast<float>(NumPieces);
+		FMath::SinCos(&BaseSin[PieceIndex], &BaseCos[PieceIndex], DeltaAngle * PieceIndex);
+		PieceScales[PieceIndex] = Settings.bAnimateScale ? Trail : 1.0f;
+		PieceOpacities[PieceIndex] = Settings.bAnimateOpacity ? Trail : 1.0f;
+	}
+
+	Indices.Reset(NumPieces * 6);
+	for (int32 PieceIndex = 0; PieceIndex < NumPieces; PieceIndex++)
+	{
+		const SlateIndex FirstVertex = static_cast<SlateIndex>(PieceIndex * 4);
+		Indices.Add(FirstVertex);
+		Indices.Add(FirstVertex + 1);
+		Indices.Add(FirstVertex + 2);
+		Indices.Add(FirstVertex + 2);
+		Indices.Add(FirstVertex + 1);
+		Indices.Add(FirstVertex + 3);
+	}
+
+	Vertices.Reset(NumPieces * 4);
+	ResourceHandle = FSlateResourceHandle();
+}
+
+FVector2D FBatchedThrobberGeometry::GetDesiredSize() const
+{
+	return FVector2D(Settings.Radius, Settings.Radius) * 2.0f;
+}
+
+void FBatchedThrobberGeometry::UpdateResourceHandle() const
+{
+	// The handle stops being valid when the resource is released, the image is looked up again then
+	if (!ResourceHandle.IsValid())
+	{
+		ResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(Settings.Image);
+		const FSlateShaderResourceProxy* ResourceProxy = ResourceHandle.GetResourceProxy();
+
+		// Atlased images only take part of the texture
+		StartUV = ResourceProxy ? ResourceProxy->StartUV : FVector2D::ZeroVector;
+		SizeUV = ResourceProxy ? ResourceProxy->SizeUV : FVector2D::UnitVector;
+	}
+}
+
+int32 FBatchedThrobberGeometry::Paint(const FGeometry& AllottedGeometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_BatchedThrobberPaint);
+
+	if (NumPieces == 0 || Settings.Image.DrawAs == ESlateBrushDrawType::NoDrawType)
+	{
+		return LayerId;
+	}
+
+	UpdateResourceHandle();
+
+	// Rotating every piece by the phase is an angle addition, which only needs the sine and cosine of the phase
+	float PhaseSin = 0.0f;
+	float PhaseCos = 1.0f;
+	if (Settings.Period > 0.0f)
+	{
+		const float Phase = static_cast<float>(FMath::Fmod(CurrentTime, static_cast<double>(Settings.Period)) / Settings.Period) * 2.0f * PI;
+		FMath::SinCos(&PhaseSin, &PhaseCos, Phase);
+	}
+
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	const FVector2D LocalOffset = (LocalSize - Settings.Image.ImageSize) * 0.5f;
+	const FVector2D LocalCenter = LocalSize * 0.5f;
+
+	const VectorRegister VPhaseSin = VectorSetFloat1(PhaseSin);
+	const VectorRegister VPhaseCos = VectorSetFloat1(PhaseCos);
+	const VectorRegister VOffsetX = VectorSetFloat1(LocalOffset.X);
+	const VectorRegister VOffsetY = VectorSetFloat1(LocalOffset.Y);
+	const VectorRegister VCenterX = VectorSetFloat1(LocalCenter.X);
+	const VectorRegister VCenterY = VectorSetFloat1(LocalCenter.Y);
+	const VectorRegister VHalfImageX = VectorSetFloat1(Settings.Image.ImageSize.X * 0.5f);
+	const VectorRegister VHalfImageY = VectorSetFloat1(Settings.Image.ImageSize.Y * 0.5f);
+
+	for (int32 PieceIndex = 0; PieceIndex < BaseCos.Num(); PieceIndex += 4)
+	{
+		const VectorRegister VBaseSin = VectorLoad(&BaseSin[PieceIndex]);
+		const VectorRegister VBaseCos = VectorLoad(&BaseCos[PieceIndex]);
+		const VectorRegister VScale = VectorLoad(&PieceScales[PieceIndex]);
+
+		// sin(A + P) = sin(A) cos(P) + cos(A) sin(P), cos(A + P) = cos(A) cos(P) - sin(A) sin(P)
+		const VectorRegister VSin = VectorMultiplyAdd(VBaseSin, VPhaseCos, VectorMultiply(VBaseCos, VPhaseSin));
+		const VectorRegister VCos = VectorSubtract(VectorMultiply(VBaseCos, VPhaseCos), VectorMultiply(VBaseSin, VPhaseSin));
+
+		VectorStore(VectorMultiplyAdd(VOffsetX, VSin, VCenterX), &CenterX[PieceIndex]);
+		VectorStore(VectorMultiplyAdd(VOffsetY, VCos, VCenterY), &CenterY[PieceIndex]);
+		VectorStore(VectorMultiply(VHalfImageX, VScale), &HalfWidth[PieceIndex]);
+		VectorStore(VectorMultiply(VHalfImageY, VScale), &HalfHeight[PieceIndex]);
+	}
+
+	const FSlateRenderTransform& RenderTransform = AllottedGeometry.GetAccumulatedRenderTransform();
+	const FLinearColor Color = Settings.Image.GetTint(InWidgetStyle) * InWidgetStyle.GetColorAndOpacityTint();
+	const FVector2D EndUV = StartUV + SizeUV;
+
+	Vertices.Reset(NumPieces * 4);
+	for (int32 PieceIndex = 0; PieceIndex < NumPieces; PieceIndex++)
+	{
+		FLinearColor PieceColor = Color;
+		PieceColor.A *= PieceOpacities[PieceIndex];
+		const FColor VertexColor = PieceColor.ToFColor(true);
+
+		const float Left = CenterX[PieceIndex] - HalfWidth[PieceIndex];
+		const float Right = CenterX[PieceIndex] + HalfWidth[PieceIndex];
+		const float Top = CenterY[PieceIndex] - HalfHeight[PieceIndex];
+		const float Bottom = CenterY[PieceIndex] + HalfHeight[PieceIndex];
+
+		Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2D(Left, Top), FVector2D(StartUV.X, StartUV.Y), FVector2D::UnitVector, VertexColor));
+		Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2D(Right, Top), FVector2D(EndUV.X, StartUV.Y), FVector2D::UnitVector, VertexColor));
+		Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2D(Left, Bottom), FVector2D(StartUV.X, EndUV.Y), FVector2D::UnitVector, VertexColor));
+		Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2D(Right, Bottom), FVector2D(EndUV.X, EndUV.Y), FVector2D::UnitVector, VertexColor));
+	}
+
+	FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, ResourceHandle, Vertices, Indices, nullptr, 0, 0);
+
+	return LayerId;
+}
+
+void SBatchedThrobber::Construct(const FArguments& InArgs, const FBatchedThrobberSettings& Settings)
+{
+	ThrobberGeometry.Initialize(Settings);
+
+	if (ThrobberGeometry.HasPieces())
+	{
+		RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SBatchedThrobber::AnimateThrobber));
+	}
+}
+
+EActiveTimerReturnType SBatchedThrobber::AnimateThrobber(double InCurrentTime, float InDeltaTime)
+{
+	Invalidate(EInvalidateWidgetReason::Paint);
+	return EActiveTimerReturnType::Continue;
+}
+
+int32 SBatchedThrobber::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	return ThrobberGeometry.Paint(AllottedGeometry, Args.GetCurrentTime(), OutDrawElements, LayerId, InWidgetStyle);
+}
+
+FVector2D SBatchedThrobber::ComputeDesiredSize(float) const
+{
+	return ThrobberGeometry.GetDesiredSize();
+}
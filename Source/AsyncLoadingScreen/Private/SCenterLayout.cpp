@@ -10,42 +10,40 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Layout/SSafeZone.h"
 #include "Widgets/Layout/SDPIScaler.h"
-#include "SHorizontalLoadingWidget.h"
-#include "SVerticalLoadingWidget.h"
-#include "SBackgroundWidget.h"
-#include "STipWidget.h"
 #include "Widgets/SOverlay.h"
 #include "Widgets/Layout/SBorder.h"
+#include "LoadingScreenTrace.h"
 
+DECLARE_CYCLE_STAT(TEXT("Center Layout Construct"), STAT_CenterLayoutConstruct, STATGROUP_AsyncLoadingScreen);
 
-void SCenterLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FCenterLayoutSettings& LayoutSettings)
+
+void SCenterLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_CenterLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+	const FCenterLayoutSettings& LayoutSettings = InRenderPlan->GetCenter();
+
 	// Root widget and background
 	TSharedRef<SOverlay> Root = SNew(SOverlay)
 		+ SOverlay::Slot()
 		.HAlign(HAlign_Fill)
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SBackgroundWidget, Settings.Background)
+			ConstructBackgroundWidget(Settings.Background)
 		];
 
-	// Placeholder for loading widget
-	TSharedRef<SWidget> LoadingWidget = SNullWidget::NullWidget;
-	if (Settings.LoadingWidget.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
-	{
-		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings.LoadingWidget);
-	}
-	else
-	{
-		LoadingWidget = SNew(SVerticalLoadingWidget, Settings.LoadingWidget);
-	}
+	// Construct loading widget
+	ConstructLoadingWidget(Settings.LoadingWidget);
 
 	// Add loading widget at center
 	Root->AddSlot()
 		.HAlign(HAlign_Center)
 		.VAlign(VAlign_Center)
 		[
-			LoadingWidget
+			LoadingWidget.ToSharedRef()
 		];
 
 
@@ -72,7 +70,7 @@ void SCenterLayout::Construct(const FArguments& InArgs, const FALoadingScreenSet
 						SNew(SDPIScaler)
 						.DPIScale(this, &SCenterLayout::GetDPIScale)
 						[					
-							SNew(STipWidget, Settings.TipWidget)
+							ConstructTipWidget(Settings.TipWidget)
 						]
 					]					
 				]
@@ -101,7 +99,7 @@ void SCenterLayout::Construct(const FArguments& InArgs, const FALoadingScreenSet
 						SNew(SDPIScaler)
 						.DPIScale(this, &SCenterLayout::GetDPIScale)
 						[					
-							SNew(STipWidget, Settings.TipWidget)
+							ConstructTipWidget(Settings.TipWidget)
 						]						
 					]					
 				]
@@ -111,6 +109,6 @@ void SCenterLayout::Construct(const FArguments& InArgs, const FALoadingScreenSet
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		ConstructStaticLayer(Root, Settings)
 	];
 }
@@ -10,33 +10,34 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Layout/SSafeZone.h"
 #include "Widgets/Layout/SDPIScaler.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSpacer.h"
-#include "SHorizontalLoadingWidget.h"
-#include "SVerticalLoadingWidget.h"
-#include "SBackgroundWidget.h"
-#include "STipWidget.h"
+#include "LoadingScreenTrace.h"
 
-void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FClassicLayoutSettings& LayoutSettings)
+DECLARE_CYCLE_STAT(TEXT("Classic Layout Construct"), STAT_ClassicLayoutConstruct, STATGROUP_AsyncLoadingScreen);
+
+void SClassicLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_ClassicLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+	const FClassicLayoutSettings& LayoutSettings = InRenderPlan->GetClassic();
+
 	// Root widget and background
 	TSharedRef<SOverlay> Root = SNew(SOverlay)
 		+ SOverlay::Slot()
 		.HAlign(HAlign_Fill)
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SBackgroundWidget, Settings.Background)
+			ConstructBackgroundWidget(Settings.Background)
 		];
 
-	// Placeholder for loading widget
-	TSharedRef<SWidget> LoadingWidget = SNullWidget::NullWidget;
-	if (Settings.LoadingWidget.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
-	{
-		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings.LoadingWidget);
-	}
-	else
-	{
-		LoadingWidget = SNew(SVerticalLoadingWidget, Settings.LoadingWidget);
-	}
+	// Construct loading widget
+	ConstructLoadingWidget(Settings.LoadingWidget);
 
 	TSharedRef<SHorizontalBox> HorizontalBox = SNew(SHorizontalBox);
 
@@ -48,7 +49,7 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(HAlign_Center)
 			.AutoWidth()
 			[
-				LoadingWidget
+				LoadingWidget.ToSharedRef()
 			];
 
 		// Add spacer at midder
@@ -67,7 +68,7 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(LayoutSettings.TipAlignment.HorizontalAlignment)
 			.VAlign(LayoutSettings.TipAlignment.VerticalAlignment)
 			[
-				SNew(STipWidget, Settings.TipWidget)
+				ConstructTipWidget(Settings.TipWidget)
 			];
 	}
 	else
@@ -79,7 +80,7 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.VAlign(LayoutSettings.TipAlignment.VerticalAlignment)
 			[
 				// Add tip text
-				SNew(STipWidget, Settings.TipWidget)
+				ConstructTipWidget(Settings.TipWidget)
 			];
 
 		// Add spacer at midder
@@ -98,7 +99,7 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(HAlign_Center)
 			.AutoWidth()
 			[
-				LoadingWidget
+				LoadingWidget.ToSharedRef()
 			];
 	}
 
@@ -143,6 +144,6 @@ void SClassicLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 	// Add root to this widget
 	ChildSlot
 		[
-			Root
+			ConstructStaticLayer(Root, Settings)
 		];
 }
@@ -11,33 +11,33 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Layout/SSafeZone.h"
 #include "Widgets/Layout/SDPIScaler.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSpacer.h"
-#include "SHorizontalLoadingWidget.h"
-#include "SVerticalLoadingWidget.h"
-#include "SBackgroundWidget.h"
-#include "STipWidget.h"
+#include "LoadingScreenTrace.h"
 
-void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FDualSidebarLayoutSettings& LayoutSettings)
+DECLARE_CYCLE_STAT(TEXT("Dual Sidebar Layout Construct"), STAT_DualSidebarLayoutConstruct, STATGROUP_AsyncLoadingScreen);
+
+void SDualSidebarLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_DualSidebarLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+	const FDualSidebarLayoutSettings& LayoutSettings = InRenderPlan->GetDualSidebar();
+
 	// Root widget and background
 	TSharedRef<SOverlay> Root = SNew(SOverlay)
 		+ SOverlay::Slot()
 		.HAlign(HAlign_Fill)
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SBackgroundWidget, Settings.Background)
+			ConstructBackgroundWidget(Settings.Background)
 		];
 
-	// Placeholder for loading widget
-	TSharedRef<SWidget> LoadingWidget = SNullWidget::NullWidget;
-	if (Settings.LoadingWidget.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
-	{
-		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings.LoadingWidget);
-	}
-	else
-	{
-		LoadingWidget = SNew(SVerticalLoadingWidget, Settings.LoadingWidget);
-	}
+	// Construct loading widget
+	ConstructLoadingWidget(Settings.LoadingWidget);
 
 
 
@@ -63,7 +63,7 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 					SNew(SDPIScaler)
 					.DPIScale(this, &SDualSidebarLayout::GetDPIScale)
 					[
-						LoadingWidget
+						LoadingWidget.ToSharedRef()
 					]
 				]
 			]
@@ -89,7 +89,7 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 					SNew(SDPIScaler)
 					.DPIScale(this, &SDualSidebarLayout::GetDPIScale)
 					[
-						SNew(STipWidget, Settings.TipWidget)
+						ConstructTipWidget(Settings.TipWidget)
 					]
 				]
 			]
@@ -118,7 +118,7 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 					SNew(SDPIScaler)
 					.DPIScale(this, &SDualSidebarLayout::GetDPIScale)
 					[
-						SNew(STipWidget, Settings.TipWidget)						
+						ConstructTipWidget(Settings.TipWidget)						
 					]
 				]
 			]
@@ -144,7 +144,7 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 					SNew(SDPIScaler)
 					.DPIScale(this, &SDualSidebarLayout::GetDPIScale)
 					[
-						LoadingWidget
+						LoadingWidget.ToSharedRef()
 					]
 				]
 			]
@@ -154,6 +154,6 @@ void SDualSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScre
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		ConstructStaticLayer(Root, Settings)
 	];
 }
@@ -0,0 +1,148 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "SEarlyStartupSplash.h"
+#include "AsyncLoadingScreen.h"
+#include "Brushes/SlateDynamicImageBrush.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Layout/SBorder.h"
+#include "IImageWrapperModule.h"
+#include "Async/Async.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+
+static const TCHAR* EarlyStartupSplashSection = TEXT("/Script/AsyncLoadingScreen.EarlyStartupSplash");
+
+FEarlyStartupSplashSettings FEarlyStartupSplashSettings::Load()
+{
+	FEarlyStartupSplashSettings Settings;
+	if (GConfig == nullptr)
+	{
+		return Settings;
+	}
+
+	GConfig->GetBool(EarlyStartupSplashSection, TEXT("bEnabled"), Settings.bEnabled, GGameIni);
+	GConfig->GetString(EarlyStartupSplashSection, TEXT("ImageDirectory"), Settings.ImageDirectory, GGameIni);
+	GConfig->GetBool(EarlyStartupSplashSection, TEXT("bRandomImage"), Settings.bRandomImage, GGameIni);
+	GConfig->GetFloat(EarlyStartupSplashSection, TEXT("MinimumDisplayTime"), Settings.MinimumDisplayTime, GGameIni);
+
+	FString BackgroundColor;
+	if (GConfig->GetString(EarlyStartupSplashSection, TEXT("BackgroundColor"), BackgroundColor, GGameIni))
+	{
+		Settings.BackgroundColor.InitFromString(BackgroundColor);
+	}
+
+	// Match the names by hand, going through the EStretch reflection data would need UObjects
+	FString ImageStretch;
+	if (GConfig->GetString(EarlyStartupSplashSection, TEXT("ImageStretch"), ImageStretch, GGameIni))
+	{
+		static const TPair<const TCHAR*, EStretch::Type> StretchNames[] =
+		{
+			{ TEXT("None"), EStretch::None },
+			{ TEXT("Fill"), EStretch::Fill },
+			{ TEXT("ScaleToFit"), EStretch::ScaleToFit },
+			{ TEXT("ScaleToFitX"), EStretch::ScaleToFitX },
+			{ TEXT("ScaleToFitY"), EStretch::ScaleToFitY },
+			{ TEXT("ScaleToFill"), EStretch::ScaleToFill },
+			{ TEXT("ScaleBySafeZone"), EStretch::ScaleBySafeZone },
+			{ TEXT("UserSpecified"), EStretch::UserSpecified }
+		};
+
+		for (const TPair<const TCHAR*, EStretch::Type>& StretchName : StretchNames)
+		{
+			if (ImageStretch.Equals(StretchName.Key, ESearchCase::IgnoreCase))
+			{
+				Settings.ImageStretch = StretchName.Value;
+				break;
+			}
+		}
+	}
+
+	return Settings;
+}
+
+void SEarlyStartupSplash::Construct(const FArguments& InArgs, const FEarlyStartupSplashSettings& Settings)
+{
+	ChildSlot
+	[
+		SNew(SBorder)
+		.HAlign(HAlign_Fill)
+		.VAlign(VAlign_Fill)
+		.BorderBackgroundColor(Settings.BackgroundColor)
+		.BorderImage(FCoreStyle::Get().GetBrush("WhiteBrush"))
+		[
+			SNew(SScaleBox)
+			.Stretch(Settings.ImageStretch)
+			[
+				SAssignNew(Image, SImage)
+				.Image(nullptr)
+			]
+		]
+	];
+
+	TArray<FString> ImageFiles;
+	FLoadingScreenImageDecoder::FindImageFiles(FPaths::Combine(FPaths::ProjectContentDir(), Settings.ImageDirectory), ImageFiles);
+	if (ImageFiles.Num() == 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("No PNG or JPEG files found for the early startup splash in %s."), *Settings.ImageDirectory);
+		return;
+	}
+
+	DecodeState = MakeShared<FDecodeState, ESPMode::ThreadSafe>();
+	DecodeState->FilePath = ImageFiles[Settings.bRandomImage ? FMath::RandRange(0, ImageFiles.Num() - 1) : 0];
+
+	// The module has to be loaded on this thread, the decoding itself is thread safe
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	// Use a dedicated thread so the decode doesn't queue up behind the startup work in the thread pool
+	TSharedPtr<FDecodeState, ESPMode::ThreadSafe> State = DecodeState;
+	Async(EAsyncExecution::Thread, [State, &ImageWrapperModule]()
+	{
+		LLM_SCOPE_LOADING_SCREEN();
+		FLoadingScreenImageDecoder::DecodeImageFile(ImageWrapperModule, State->FilePath, State->Image);
+
+		// The brush resource can only be created on the game thread, the splash shows up the next time it processes its tasks
+		AsyncTask(ENamedThreads::GameThread, [State]()
+		{
+			LLM_SCOPE_LOADING_SCREEN();
+			if (State->Image.IsValid())
+			{
+				const FName TextureName(*FString::Printf(TEXT("EarlyStartupSplash_%s"), *FPaths::GetBaseFilename(State->FilePath)));
+				State->Brush = FSlateDynamicImageBrush::CreateWithImageData(TextureName, FVector2D(State->Image.Size), State->Image.Pixels);
+			}
+
+			// The pixels have been copied into the brush resource
+			State->Image = FLoadingScreenDecodedImage();
+			State->bDone = true;
+		});
+	});
+
+	RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SEarlyStartupSplash::UpdateSplashImage));
+}
+
+EActiveTimerReturnType SEarlyStartupSplash::UpdateSplashImage(double InCurrentTime, float InDeltaTime)
+{
+	if (!DecodeState->bDone)
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	// Move the brush out so only this thread touches its reference count
+	ImageBrush = MoveTemp(DecodeState->Brush);
+	if (ImageBrush.IsValid())
+	{
+		Image->SetImage(ImageBrush.Get());
+		BrushCounter.Set(1);
+
+		// GStartTime is taken when the process starts, the brush is drawn on this frame
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Early startup splash %s (%.0fx%.0f) shown %.2f ms after launch."), *FPaths::GetCleanFilename(DecodeState->FilePath), ImageBrush->ImageSize.X, ImageBrush->ImageSize.Y, (FPlatformTime::Seconds() - GStartTime) * 1000.0);
+	}
+
+	DecodeState.Reset();
+	return EActiveTimerReturnType::Stop;
+}
@@ -22,6 +22,7 @@ void SHorizontalLoadingWidget::Construct(const FArguments& InArgs, const FLoadin
 	TSharedRef<SHorizontalBox> Root = SNew(SHorizontalBox);		
 	
 	// Construct Loading Icon Widget
+	TextureLimits = InArgs._TextureLimits;
 	ConstructLoadingIcon(Settings);
 
 	EVisibility LoadingTextVisibility;
@@ -117,6 +118,6 @@ void SHorizontalLoadingWidget::Construct(const FArguments& InArgs, const FLoadin
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		ConstructProgressBar(Root, Settings)
 	];	
 }
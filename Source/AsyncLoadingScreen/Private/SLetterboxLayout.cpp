@@ -10,32 +10,32 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Layout/SSafeZone.h"
 #include "Widgets/Layout/SDPIScaler.h"
-#include "SHorizontalLoadingWidget.h"
-#include "SVerticalLoadingWidget.h"
-#include "SBackgroundWidget.h"
-#include "STipWidget.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/Layout/SBorder.h"
+#include "LoadingScreenTrace.h"
 
-void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FLetterboxLayoutSettings& LayoutSettings)
+DECLARE_CYCLE_STAT(TEXT("Letterbox Layout Construct"), STAT_LetterboxLayoutConstruct, STATGROUP_AsyncLoadingScreen);
+
+void SLetterboxLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_LetterboxLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+	const FLetterboxLayoutSettings& LayoutSettings = InRenderPlan->GetLetterbox();
+
 	// Root widget and background
 	TSharedRef<SOverlay> Root = SNew(SOverlay)
 		+ SOverlay::Slot()
 		.HAlign(HAlign_Fill)
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SBackgroundWidget, Settings.Background)
+			ConstructBackgroundWidget(Settings.Background)
 		];
 
-	// Placeholder for loading widget
-	TSharedRef<SWidget> LoadingWidget = SNullWidget::NullWidget;
-	if (Settings.LoadingWidget.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
-	{
-		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings.LoadingWidget);
-	}
-	else
-	{
-		LoadingWidget = SNew(SVerticalLoadingWidget, Settings.LoadingWidget);
-	}
+	// Construct loading widget
+	ConstructLoadingWidget(Settings.LoadingWidget);
 	
 
 	if (LayoutSettings.bIsLoadingWidgetAtTop)
@@ -60,7 +60,7 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 						SNew(SDPIScaler)
 						.DPIScale(this, &SLetterboxLayout::GetDPIScale)
 						[
-							LoadingWidget
+							LoadingWidget.ToSharedRef()
 						]
 					]
 				]
@@ -86,7 +86,7 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 						SNew(SDPIScaler)
 						.DPIScale(this, &SLetterboxLayout::GetDPIScale)
 						[
-							SNew(STipWidget, Settings.TipWidget)
+							ConstructTipWidget(Settings.TipWidget)
 						]						
 					]
 				]
@@ -114,7 +114,7 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 						SNew(SDPIScaler)
 						.DPIScale(this, &SLetterboxLayout::GetDPIScale)
 						[					
-							SNew(STipWidget, Settings.TipWidget)
+							ConstructTipWidget(Settings.TipWidget)
 						]						
 					]
 				]
@@ -140,7 +140,7 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 						SNew(SDPIScaler)
 						.DPIScale(this, &SLetterboxLayout::GetDPIScale)
 						[
-							LoadingWidget
+							LoadingWidget.ToSharedRef()
 						]						
 					]
 				]
@@ -150,6 +150,6 @@ void SLetterboxLayout::Construct(const FArguments& InArgs, const FALoadingScreen
 	// Add Root to this widget
 	ChildSlot
 		[
-			Root
+			ConstructStaticLayer(Root, Settings)
 		];
 }
@@ -0,0 +1,741 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#include "SLightweightLayout.h"
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenTextureStreaming.h"
+#include "LoadingScreenProgress.h"
+#include "LoadingScreenBackgroundLoader.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "Internationalization/BreakIterator.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Styling/CoreStyle.h"
+#include "LoadingScreenTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lightweight Layout Construct"), STAT_LightweightLayoutConstruct, STATGROUP_AsyncLoadingScreen);
+
+namespace LightweightLayout
+{
+	// SBorder pads its content by default
+	const FMargin BorderPadding(2.0f);
+
+	/** Fraction of the free space put before the content, a negative value fills the area */
+	float GetAlignment(EHorizontalAlignment HAlign)
+	{
+		return HAlign == HAlign_Left ? 0.0f : HAlign == HAlign_Center ? 0.5f : HAlign == HAlign_Right ? 1.0f : -1.0f;
+	}
+
+	float GetAlignment(EVerticalAlignment VAlign)
+	{
+		return VAlign == VAlign_Top ? 0.0f : VAlign == VAlign_Center ? 0.5f : VAlign == VAlign_Bottom ? 1.0f : -1.0f;
+	}
+
+	/** Aligns the content in the area along one axis, the content never gets bigger than the area */
+	void AlignAxis(float Alignment, float AreaPosition, float AreaSize, float DesiredSize, float& OutPosition, float& OutSize)
+	{
+		if (Alignment < 0.0f)
+		{
+			OutPosition = AreaPosition;
+			OutSize = AreaSize;
+		}
+		else
+		{
+			OutSize = FMath::Min(DesiredSize, AreaSize);
+			OutPosition = AreaPosition + (AreaSize - OutSize) * Alignment;
+		}
+	}
+
+	/** Aligns the content in the area, the same way a slot with these alignments would */
+	void AlignBox(EHorizontalAlignment HAlign, EVerticalAlignment VAlign, const FVector2D& AreaPosition, const FVector2D& AreaSize, const FVector2D& DesiredSize, FVector2D& OutPosition, FVector2D& OutSize)
+	{
+		AlignAxis(GetAlignment(HAlign), AreaPosition.X, AreaSize.X, DesiredSize.X, OutPosition.X, OutSize.X);
+		AlignAxis(GetAlignment(VAlign), AreaPosition.Y, AreaSize.Y, DesiredSize.Y, OutPosition.Y, OutSize.Y);
+	}
+
+	/** Size of the text block with its shadow, it's empty if there's no text */
+	FVector2D GetTextBlockSize(const FVector2D& TextSize, const FTextAppearance& Appearance)
+	{
+		return TextSize.IsZero() ? FVector2D::ZeroVector : TextSize + Appearance.ShadowOffset.GetAbs();
+	}
+}
+
+void SLightweightLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_LightweightLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+
+	const FBackgroundSettings& Background = Settings.Background;
+	BackgroundLoader = MakeShared<FLoadingScreenBackgroundLoader, ESPMode::ThreadSafe>(Background, InRenderPlan->GetTextureLimits());
+	BackgroundStretch = Background.ImageStretch;
+	BackgroundPadding = Background.Padding;
+	BackgroundColor = Background.BackgroundColor;
+
+	TipTexts = Settings.TipWidget.TipText;
+	bSetDisplayTipTextManually = Settings.TipWidget.bSetDisplayTipTextManually;
+	TipAppearance = Settings.TipWidget.Appearance;
+	TipWrapAt = Settings.TipWidget.TipWrapAt;
+
+	LoadingWidgetSettings = Settings.LoadingWidget;
+	if (LoadingWidgetSettings.LoadingIconType == ELoadingIconType::LIT_BatchedThrobber)
+	{
+		BatchedThrobber.Initialize(LoadingWidgetSettings.BatchedThrobberSettings);
+	}
+	LoadingText = WrapText(LoadingWidgetSettings.LoadingText, LoadingWidgetSettings.Appearance.Font, 0.0f);
+	if (LoadingWidgetSettings.bShowProgressBar)
+	{
+		LoadingProgress = FAsyncLoadingScreenModule::Get().GetLoadingProgress();
+	}
+
+	// Same padding SSafeZone adds for the title safe area
+	FDisplayMetrics DisplayMetrics;
+	FSlateApplication::Get().GetCachedDisplayMetrics(DisplayMetrics);
+	SafeMargin = FMargin(DisplayMetrics.TitleSafePaddingSize.X, DisplayMetrics.TitleSafePaddingSize.Y, DisplayMetrics.TitleSafePaddingSize.Z, DisplayMetrics.TitleSafePaddingSize.W);
+
+	switch (Settings.Layout)
+	{
+	case EAsyncLoadingScreenLayout::ALSL_Center:
+		AddPanels(InRenderPlan->GetCenter());
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Letterbox:
+		AddPanels(InRenderPlan->GetLetterbox());
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Sidebar:
+		AddPanels(InRenderPlan->GetSidebar());
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_DualSidebar:
+		AddPanels(InRenderPlan->GetDualSidebar());
+		break;
+	case EAsyncLoadingScreenLayout::ALSL_Classic:
+	default:
+		AddPanels(InRenderPlan->GetClassic());
+		break;
+	}
+
+	PickTipText();
+
+	if (BackgroundLoader->GetNumImages() > 0)
+	{
+		RequestBackgroundImage();
+	}
+}
+
+bool SLightweightLayout::CanRender(const FALoadingScreenSettings& Settings)
+{
+	if (Settings.Background.ImageFiles.Num() > 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("The lightweight layout doesn't support background image files, using the regular layout instead."));
+		return false;
+	}
+
+	if (Settings.LoadingWidget.LoadingIconType == ELoadingIconType::LIT_ImageSequence)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("The lightweight layout only supports the throbber loading icons, using the regular layout instead."));
+		return false;
+	}
+
+	return true;
+}
+
+void SLightweightLayout::AddPanels(const FClassicLayoutSettings& LayoutSettings)
+{
+	FPanel& Panel = Panels.AddDefaulted_GetRef();
+	Panel.Border = LayoutSettings.BorderBackground;
+	Panel.HAlign = LayoutSettings.BorderHorizontalAlignment;
+	Panel.VAlign = LayoutSettings.bIsWidgetAtBottom ? VAlign_Bottom : VAlign_Top;
+	Panel.Padding = LayoutSettings.BorderPadding;
+	Panel.Orientation = Orient_Horizontal;
+	Panel.Space = LayoutSettings.Space;
+
+	const FPanelSlot LoadingWidgetSlot = { ESlotContent::LoadingWidget, HAlign_Center, VAlign_Center, false };
+	const FPanelSlot TipSlot = { ESlotContent::Tip, LayoutSettings.TipAlignment.HorizontalAlignment, LayoutSettings.TipAlignment.VerticalAlignment, true };
+	if (LayoutSettings.bIsLoadingWidgetAtLeft)
+	{
+		Panel.Slots = { LoadingWidgetSlot, TipSlot };
+	}
+	else
+	{
+		Panel.Slots = { TipSlot, LoadingWidgetSlot };
+	}
+}
+
+void SLightweightLayout::AddPanels(const FCenterLayoutSettings& LayoutSettings)
+{
+	// The loading widget sits at the center of the screen, without border or UI scale
+	FPanel& LoadingWidgetPanel = Panels.AddDefaulted_GetRef();
+	LoadingWidgetPanel.HAlign = HAlign_Center;
+	LoadingWidgetPanel.VAlign = VAlign_Center;
+	LoadingWidgetPanel.bTitleSafe = false;
+	LoadingWidgetPanel.bDPIScaled = false;
+	LoadingWidgetPanel.Slots = { { ESlotContent::LoadingWidget, HAlign_Fill, VAlign_Fill, true } };
+
+	FPanel& TipPanel = Panels.AddDefaulted_GetRef();
+	TipPanel.Border = LayoutSettings.BorderBackground;
+	TipPanel.HAlign = LayoutSettings.BorderHorizontalAlignment;
+	TipPanel.VAlign = LayoutSettings.bIsTipAtBottom ? VAlign_Bottom : VAlign_Top;
+	TipPanel.Offset = LayoutSettings.bIsTipAtBottom ? FMargin(0.0f, 0.0f, 0.0f, LayoutSettings.BorderVerticalOffset) : FMargin(0.0f, LayoutSettings.BorderVerticalOffset, 0.0f, 0.0f);
+	TipPanel.Padding = LayoutSettings.BorderPadding;
+	TipPanel.ContentHAlign = LayoutSettings.TipAlignment.HorizontalAlignment;
+	TipPanel.ContentVAlign = LayoutSettings.TipAlignment.VerticalAlignment;
+	TipPanel.Slots = { { ESlotContent::Tip, HAlign_Fill, VAlign_Fill, true } };
+}
+
+void SLightweightLayout::AddPanels(const FLetterboxLayoutSettings& LayoutSettings)
+{
+	// Both panels are added first, adding to the array would invalidate the references
+	Panels.AddDefaulted(2);
+	FPanel& TopPanel = Panels[0];
+	TopPanel.Border = LayoutSettings.TopBorderBackground;
+	TopPanel.HAlign = LayoutSettings.TopBorderHorizontalAlignment;
+	TopPanel.VAlign = VAlign_Top;
+	TopPanel.Padding = LayoutSettings.TopBorderPadding;
+
+	FPanel& BottomPanel = Panels[1];
+	BottomPanel.Border = LayoutSettings.BottomBorderBackground;
+	BottomPanel.HAlign = LayoutSettings.BottomBorderHorizontalAlignment;
+	BottomPanel.VAlign = VAlign_Bottom;
+	BottomPanel.Padding = LayoutSettings.BottomBorderPadding;
+
+	FPanel& LoadingWidgetPanel = LayoutSettings.bIsLoadingWidgetAtTop ? TopPanel : BottomPanel;
+	LoadingWidgetPanel.ContentHAlign = LayoutSettings.LoadingWidgetAlignment.HorizontalAlignment;
+	LoadingWidgetPanel.ContentVAlign = LayoutSettings.LoadingWidgetAlignment.VerticalAlignment;
+	LoadingWidgetPanel.Slots = { { ESlotContent::LoadingWidget, HAlign_Fill, VAlign_Fill, true } };
+
+	FPanel& TipPanel = LayoutSettings.bIsLoadingWidgetAtTop ? BottomPanel : TopPanel;
+	TipPanel.ContentHAlign = LayoutSettings.TipAlignment.HorizontalAlignment;
+	TipPanel.ContentVAlign = LayoutSettings.TipAlignment.VerticalAlignment;
+	TipPanel.Slots = { { ESlotContent::Tip, HAlign_Fill, VAlign_Fill, true } };
+}
+
+void SLightweightLayout::AddPanels(const FSidebarLayoutSettings& LayoutSettings)
+{
+	FPanel& Panel = Panels.AddDefaulted_GetRef();
+	Panel.Border = LayoutSettings.BorderBackground;
+	Panel.HAlign = LayoutSettings.bIsWidgetAtRight ? HAlign_Right : HAlign_Left;
+	Panel.VAlign = LayoutSettings.BorderVerticalAlignment;
+	Panel.Offset = LayoutSettings.bIsWidgetAtRight ? FMargin(0.0f, 0.0f, LayoutSettings.BorderHorizontalOffset, 0.0f) : FMargin(LayoutSettings.BorderHorizontalOffset, 0.0f, 0.0f, 0.0f);
+	Panel.Padding = LayoutSettings.BorderPadding;
+	Panel.ContentVAlign = LayoutSettings.VerticalAlignment;
+	Panel.Orientation = Orient_Vertical;
+	Panel.Space = LayoutSettings.Space;
+
+	const FPanelSlot LoadingWidgetSlot = { ESlotContent::LoadingWidget, LayoutSettings.LoadingWidgetAlignment.HorizontalAlignment, LayoutSettings.LoadingWidgetAlignment.VerticalAlignment, false };
+	const FPanelSlot TipSlot = { ESlotContent::Tip, LayoutSettings.TipAlignment.HorizontalAlignment, LayoutSettings.TipAlignment.VerticalAlignment, false };
+	if (LayoutSettings.bIsLoadingWidgetAtTop)
+	{
+		Panel.Slots = { LoadingWidgetSlot, TipSlot };
+	}
+	else
+	{
+		Panel.Slots = { TipSlot, LoadingWidgetSlot };
+	}
+}
+
+void SLightweightLayout::AddPanels(const FDualSidebarLayoutSettings& LayoutSettings)
+{
+	// Both panels are added first, adding to the array would invalidate the references
+	Panels.AddDefaulted(2);
+	FPanel& RightPanel = Panels[0];
+	RightPanel.Border = LayoutSettings.RightBorderBackground;
+	RightPanel.HAlign = HAlign_Right;
+	RightPanel.VAlign = LayoutSettings.RightBorderVerticalAlignment;
+	RightPanel.Padding = LayoutSettings.RightBorderPadding;
+	RightPanel.ContentVAlign = LayoutSettings.RightVerticalAlignment;
+
+	FPanel& LeftPanel = Panels[1];
+	LeftPanel.Border = LayoutSettings.LeftBorderBackground;
+	LeftPanel.HAlign = HAlign_Left;
+	LeftPanel.VAlign = LayoutSettings.LeftBorderVerticalAlignment;
+	LeftPanel.Padding = LayoutSettings.LeftBorderPadding;
+	LeftPanel.ContentVAlign = LayoutSettings.LeftVerticalAlignment;
+
+	FPanel& LoadingWidgetPanel = LayoutSettings.bIsLoadingWidgetAtRight ? RightPanel : LeftPanel;
+	LoadingWidgetPanel.Slots = { { ESlotContent::LoadingWidget, HAlign_Fill, VAlign_Fill, true } };
+
+	FPanel& TipPanel = LayoutSettings.bIsLoadingWidgetAtRight ? LeftPanel : RightPanel;
+	TipPanel.Slots = { { ESlotContent::Tip, HAlign_Fill, VAlign_Fill, true } };
+}
+
+void SLightweightLayout::Rebind()
+{
+	SLoadingScreenLayout::Rebind();
+
+	PickTipText();
+	DisplayedProgress = -1.0f;
+	LastProgressUpdateTime = 0.0;
+
+	if (BackgroundLoader->GetNumImages() > 0)
+	{
+		BackgroundLoader->Release();
+		RequestBackgroundImage();
+	}
+}
+
+void SLightweightLayout::ReleaseResources()
+{
+	SLoadingScreenLayout::ReleaseResources();
+
+	BackgroundLoader->Release();
+}
+
+bool SLightweightLayout::IsAnimating() const
+{
+	switch (LoadingWidgetSettings.LoadingIconType)
+	{
+	case ELoadingIconType::LIT_CircularThrobber:
+		return LoadingWidgetSettings.CircularThrobberSettings.NumberOfPieces > 0;
+	case ELoadingIconType::LIT_BatchedThrobber:
+		return BatchedThrobber.HasPieces();
+	default:
+		return LoadingWidgetSettings.ThrobberSettings.NumberOfPieces > 0;
+	}
+}
+
+void SLightweightLayout::PickTipText()
+{
+	if (TipTexts.Num() > 0)
+	{
+		const int32 TipIndex = FAsyncLoadingScreenModule::Get().PickTipTextIndex(TipTexts.Num(), bSetDisplayTipTextManually);
+		TipText = WrapText(TipTexts[TipIndex], TipAppearance.Font, TipWrapAt);
+	}
+
+	// The tip size may have changed
+	ArrangedSize = FVector2D(-1.0f, -1.0f);
+}
+
+void SLightweightLayout::RequestBackgroundImage()
+{
+	BackgroundLoader->Request();
+
+	if (!bIsActiveTimerRegistered)
+	{
+		bIsActiveTimerRegistered = true;
+		RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SLightweightLayout::UpdateBackgroundImage));
+	}
+}
+
+EActiveTimerReturnType SLightweightLayout::UpdateBackgroundImage(double InCurrentTime, float InDeltaTime)
+{
+	// The brush is painted straight from the loader, there's nothing to swap here
+	BackgroundLoader->Update();
+
+	// Keep waiting until the request is done, stop if it failed
+	if (BackgroundLoader->IsRequestDone())
+	{
+		bIsActiveTimerRegistered = false;
+		return EActiveTimerReturnType::Stop;
+	}
+
+	return EActiveTimerReturnType::Continue;
+}
+
+SLightweightLayout::FWrappedText SLightweightLayout::WrapText(const FText& Text, const FSlateFontInfo& Font, float WrapAt)
+{
+	FWrappedText WrappedText;
+	if (Text.IsEmpty())
+	{
+		return WrappedText;
+	}
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	WrappedText.LineHeight = FontMeasure->GetMaxCharacterHeight(Font);
+
+	auto AddLine = [&WrappedText, &FontMeasure, &Font](const FString& Line)
+	{
+		const float LineWidth = FontMeasure->Measure(Line, Font).X;
+		WrappedText.Lines.Add(Line);
+		WrappedText.LineWidths.Add(LineWidth);
+		WrappedText.Size.X = FMath::Max(WrappedText.Size.X, LineWidth);
+	};
+
+	TArray<FString> Paragraphs;
+	Text.ToString().ParseIntoArray(Paragraphs, TEXT("\n"), false);
+
+	const TSharedRef<IBreakIterator> LineBreakIterator = FBreakIterator::CreateLineBreakIterator();
+
+	for (const FString& Paragraph : Paragraphs)
+	{
+		if (WrapAt <= 0.0f)
+		{
+			AddLine(Paragraph);
+			continue;
+		}
+
+		// Break at the last line break opportunity that keeps the line within WrapAt, a word wider than that gets a line of its own.
+		// The break iterator knows the rules of every script, e.g. CJK breaks between characters and Thai between words without spaces
+		LineBreakIterator->SetString(Paragraph);
+
+		int32 LineStart = 0;
+		int32 LastFit = 0;
+		for (int32 BreakPosition = LineBreakIterator->MoveToNext(); BreakPosition != INDEX_NONE; BreakPosition = LineBreakIterator->MoveToNext())
+		{
+			const FString Candidate = Paragraph.Mid(LineStart, BreakPosition - LineStart).TrimEnd();
+			if (LastFit > LineStart && FontMeasure->Measure(Candidate, Font).X > WrapAt)
+			{
+				AddLine(Paragraph.Mid(LineStart, LastFit - LineStart).TrimEnd());
+				LineStart = LastFit;
+			}
+			LastFit = BreakPosition;
+		}
+
+		AddLine(Paragraph.Mid(LineStart).TrimEnd());
+		LineBreakIterator->ClearString();
+	}
+
+	WrappedText.Size.Y = WrappedText.LineHeight * WrappedText.Lines.Num();
+	return WrappedText;
+}
+
+FVector2D SLightweightLayout::GetLoadingIconSize() const
+{
+	if (LoadingWidgetSettings.LoadingIconType == ELoadingIconType::LIT_CircularThrobber)
+	{
+		const float Diameter = LoadingWidgetSettings.CircularThrobberSettings.Radius * 2.0f;
+		return FVector2D(Diameter, Diameter);
+	}
+
+	if (LoadingWidgetSettings.LoadingIconType == ELoadingIconType::LIT_BatchedThrobber)
+	{
+		return BatchedThrobber.GetDesiredSize();
+	}
+
+	const FThrobberSettings& ThrobberSettings = LoadingWidgetSettings.ThrobberSettings;
+	return FVector2D(ThrobberSettings.Image.ImageSize.X * ThrobberSettings.NumberOfPieces, ThrobberSettings.Image.ImageSize.Y);
+}
+
+FVector2D SLightweightLayout::GetSlotDesiredSize(ESlotContent Content) const
+{
+	if (Content == ESlotContent::Tip)
+	{
+		return LightweightLayout::GetTextBlockSize(TipText.Size, TipAppearance);
+	}
+
+	// Loading icon, space and loading text stacked like the horizontal and vertical loading widgets do, with the progress bar under them
+	const FVector2D ContentSize = GetLoadingContentSize();
+	if (!LoadingWidgetSettings.bShowProgressBar)
+	{
+		return ContentSize;
+	}
+
+	const FProgressBarSettings& ProgressBarSettings = LoadingWidgetSettings.ProgressBarSettings;
+	return FVector2D(FMath::Max(ContentSize.X, ProgressBarSettings.Size.X), ContentSize.Y + ProgressBarSettings.Space + ProgressBarSettings.Size.Y);
+}
+
+FVector2D SLightweightLayout::GetLoadingContentSize() const
+{
+	const FVector2D IconSize = GetLoadingIconSize();
+	const FVector2D TextSize = LightweightLayout::GetTextBlockSize(LoadingText.Size, LoadingWidgetSettings.Appearance);
+
+	if (LoadingWidgetSettings.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
+	{
+		return FVector2D(IconSize.X + LoadingWidgetSettings.Space + TextSize.X, FMath::Max(IconSize.Y, TextSize.Y));
+	}
+
+	return FVector2D(FMath::Max(IconSize.X, TextSize.X), IconSize.Y + LoadingWidgetSettings.Space + TextSize.Y);
+}
+
+void SLightweightLayout::Arrange(const FVector2D& Size, float DPIScale) const
+{
+	ArrangedSize = Size;
+	ArrangedDPIScale = DPIScale;
+	ArrangedBorders.SetNum(Panels.Num());
+
+	for (int32 PanelIndex = 0; PanelIndex < Panels.Num(); PanelIndex++)
+	{
+		const FPanel& Panel = Panels[PanelIndex];
+		const float Scale = Panel.bDPIScaled ? DPIScale : 1.0f;
+		const int32 Axis = Panel.Orientation == Orient_Horizontal ? 0 : 1;
+		const int32 CrossAxis = 1 - Axis;
+		const float Space = Panel.Space * Scale;
+
+		// Desired size of the slots stacked along the panel
+		TArray<FVector2D, TInlineAllocator<2>> SlotSizes;
+		FVector2D StackSize = FVector2D::ZeroVector;
+		float AutoSize = 0.0f;
+		int32 NumFillSlots = 0;
+		for (const FPanelSlot& Slot : Panel.Slots)
+		{
+			const FVector2D SlotSize = GetSlotDesiredSize(Slot.Content) * Scale;
+			SlotSizes.Add(SlotSize);
+			StackSize[Axis] += SlotSize[Axis];
+			StackSize[CrossAxis] = FMath::Max(StackSize[CrossAxis], SlotSize[CrossAxis]);
+			AutoSize += Slot.bFill ? 0.0f : SlotSize[Axis];
+			NumFillSlots += Slot.bFill ? 1 : 0;
+		}
+		const float SpaceSize = Space * FMath::Max(Panel.Slots.Num() - 1, 0);
+		StackSize[Axis] += SpaceSize;
+
+		// The border hugs the padded slots unless it's aligned to fill the screen
+		const FMargin Padding = Panel.Padding + (Panel.bTitleSafe ? SafeMargin : FMargin(0.0f)) + (Panel.Border.IsSet() ? LightweightLayout::BorderPadding : FMargin(0.0f));
+		FArrangedBox& Border = ArrangedBorders[PanelIndex];
+		LightweightLayout::AlignBox(Panel.HAlign, Panel.VAlign, FVector2D(Panel.Offset.Left, Panel.Offset.Top), Size - Panel.Offset.GetDesiredSize(),
+			StackSize + Padding.GetDesiredSize(), Border.Position, Border.Size);
+
+		FVector2D StackPosition;
+		LightweightLayout::AlignBox(Panel.ContentHAlign, Panel.ContentVAlign, Border.Position + FVector2D(Padding.Left, Padding.Top), Border.Size - Padding.GetDesiredSize(),
+			StackSize, StackPosition, StackSize);
+
+		// Auto sized slots get their desired size, the fill slots share what's left
+		const float FillSize = NumFillSlots > 0 ? FMath::Max(StackSize[Axis] - AutoSize - SpaceSize, 0.0f) / NumFillSlots : 0.0f;
+
+		float Cursor = StackPosition[Axis];
+		for (int32 SlotIndex = 0; SlotIndex < Panel.Slots.Num(); SlotIndex++)
+		{
+			const FPanelSlot& Slot = Panel.Slots[SlotIndex];
+
+			FVector2D SlotPosition = StackPosition;
+			FVector2D SlotSize = StackSize;
+			SlotPosition[Axis] = Cursor;
+			SlotSize[Axis] = Slot.bFill ? FillSize : SlotSizes[SlotIndex][Axis];
+			Cursor += SlotSize[Axis] + Space;
+
+			FArrangedBox Content;
+			Content.Scale = Scale;
+			LightweightLayout::AlignBox(Slot.HAlign, Slot.VAlign, SlotPosition, SlotSize, SlotSizes[SlotIndex], Content.Position, Content.Size);
+
+			if (Slot.Content == ESlotContent::Tip)
+			{
+				ArrangedTip = Content;
+			}
+			else
+			{
+				ArrangeLoadingWidget(Content);
+			}
+		}
+	}
+}
+
+void SLightweightLayout::ArrangeLoadingWidget(const FArrangedBox& InBox) const
+{
+	// The progress bar goes centered under the content, which only gets its desired height then
+	FArrangedBox Box = InBox;
+	if (LoadingWidgetSettings.bShowProgressBar)
+	{
+		const FProgressBarSettings& ProgressBarSettings = LoadingWidgetSettings.ProgressBarSettings;
+		Box.Size.Y = GetLoadingContentSize().Y * Box.Scale;
+
+		ArrangedProgressBar.Scale = Box.Scale;
+		ArrangedProgressBar.Size = ProgressBarSettings.Size * Box.Scale;
+		ArrangedProgressBar.Position.X = Box.Position.X + (Box.Size.X - ArrangedProgressBar.Size.X) * 0.5f;
+		ArrangedProgressBar.Position.Y = Box.Position.Y + Box.Size.Y + ProgressBarSettings.Space * Box.Scale;
+	}
+
+	const bool bHorizontal = LoadingWidgetSettings.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal;
+	const bool bTextFirst = bHorizontal ? !LoadingWidgetSettings.bLoadingTextRightPosition : LoadingWidgetSettings.bLoadingTextTopPosition;
+	const int32 Axis = bHorizontal ? 0 : 1;
+
+	const FVector2D IconSize = GetLoadingIconSize() * Box.Scale;
+	const FVector2D TextSize = LightweightLayout::GetTextBlockSize(LoadingText.Size, LoadingWidgetSettings.Appearance) * Box.Scale;
+	const float Space = LoadingWidgetSettings.Space * Box.Scale;
+
+	// Auto sized slots are stacked from the start of the box, they're only aligned across it
+	auto ArrangeSlot = [&Box, Axis, bHorizontal](const FWidgetAlignment& Alignment, float Position, const FVector2D& DesiredSize, FArrangedBox& OutBox)
+	{
+		FVector2D SlotPosition = Box.Position;
+		FVector2D SlotSize = Box.Size;
+		SlotPosition[Axis] += Position;
+		SlotSize[Axis] = DesiredSize[Axis];
+
+		OutBox.Scale = Box.Scale;
+		LightweightLayout::AlignBox(bHorizontal ? HAlign_Left : Alignment.HorizontalAlignment.GetValue(), bHorizontal ? Alignment.VerticalAlignment.GetValue() : VAlign_Top,
+			SlotPosition, SlotSize, DesiredSize, OutBox.Position, OutBox.Size);
+	};
+
+	if (bTextFirst)
+	{
+		ArrangeSlot(LoadingWidgetSettings.TextAlignment, 0.0f, TextSize, ArrangedLoadingText);
+		ArrangeSlot(LoadingWidgetSettings.LoadingIconAlignment, TextSize[Axis] + Space, IconSize, ArrangedLoadingIcon);
+	}
+	else
+	{
+		ArrangeSlot(LoadingWidgetSettings.LoadingIconAlignment, 0.0f, IconSize, ArrangedLoadingIcon);
+		ArrangeSlot(LoadingWidgetSettings.TextAlignment, IconSize[Axis] + Space, TextSize, ArrangedLoadingText);
+	}
+}
+
+int32 SLightweightLayout::PaintLayout(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+	const float DPIScale = GetDPIScale();
+	if (Size != ArrangedSize || DPIScale != ArrangedDPIScale)
+	{
+		Arrange(Size, DPIScale);
+	}
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+	// Background color and image
+	if (BackgroundLoader->GetNumImages() > 0)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), FCoreStyle::Get().GetBrush("WhiteBrush"), ESlateDrawEffect::None, BackgroundColor * Tint);
+
+		if (const FSlateBrush* Brush = BackgroundLoader->GetBrush())
+		{
+			const FVector2D AreaSize = Size - BackgroundPadding.GetDesiredSize();
+			const FVector2D ImageSize = BackgroundStretch == EStretch::Fill ? AreaSize
+				: Brush->ImageSize * FLoadingScreenTextureStreaming::GetStretchScale(BackgroundStretch, Brush->ImageSize, AreaSize);
+			const FVector2D ImagePosition = FVector2D(BackgroundPadding.Left, BackgroundPadding.Top) + (AreaSize - ImageSize) * 0.5f;
+
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(ImagePosition, ImageSize), Brush, ESlateDrawEffect::None, Brush->GetTint(InWidgetStyle) * Tint);
+		}
+	}
+	LayerId += 2;
+
+	// Borders
+	for (int32 PanelIndex = 0; PanelIndex < Panels.Num(); PanelIndex++)
+	{
+		const FPanel& Panel = Panels[PanelIndex];
+		if (Panel.Border.IsSet() && Panel.Border->DrawAs != ESlateBrushDrawType::NoDrawType)
+		{
+			const FArrangedBox& Border = ArrangedBorders[PanelIndex];
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Border.Position, Border.Size), &Panel.Border.GetValue(), ESlateDrawEffect::None, Panel.Border->GetTint(InWidgetStyle) * Tint);
+		}
+	}
+	LayerId++;
+
+	// Contents, painted at their UI scale
+	auto MakeContentGeometry = [&AllottedGeometry](const FArrangedBox& Box)
+	{
+		return AllottedGeometry.MakeChild(Box.Size / Box.Scale, FSlateLayoutTransform(Box.Scale, Box.Position));
+	};
+
+	int32 MaxLayerId = PaintText(MakeContentGeometry(ArrangedTip), TipText, TipAppearance, OutDrawElements, LayerId, InWidgetStyle);
+	MaxLayerId = FMath::Max(MaxLayerId, PaintText(MakeContentGeometry(ArrangedLoadingText), LoadingText, LoadingWidgetSettings.Appearance, OutDrawElements, LayerId, InWidgetStyle));
+
+	const FGeometry IconGeometry = AllottedGeometry.MakeChild(ArrangedLoadingIcon.Size / ArrangedLoadingIcon.Scale, FSlateLayoutTransform(ArrangedLoadingIcon.Scale, ArrangedLoadingIcon.Position),
+		FSlateRenderTransform(FScale2D(LoadingWidgetSettings.TransformScale), LoadingWidgetSettings.TransformTranslation), LoadingWidgetSettings.TransformPivot);
+	MaxLayerId = FMath::Max(MaxLayerId, PaintLoadingIcon(IconGeometry, Args.GetCurrentTime(), OutDrawElements, LayerId, InWidgetStyle));
+
+	if (LoadingProgress.IsValid())
+	{
+		MaxLayerId = FMath::Max(MaxLayerId, PaintProgressBar(AllottedGeometry, Args.GetCurrentTime(), OutDrawElements, LayerId, InWidgetStyle));
+	}
+
+	return MaxLayerId;
+}
+
+int32 SLightweightLayout::PaintText(const FGeometry& Geometry, const FWrappedText& Text, const FTextAppearance& Appearance, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const
+{
+	if (Text.Lines.Num() == 0)
+	{
+		return LayerId;
+	}
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+	const FLinearColor TextColor = Appearance.ColorAndOpacity.GetColor(InWidgetStyle) * Tint;
+	const FLinearColor ShadowColor = Appearance.ShadowColorAndOpacity * Tint;
+	const bool bHasShadow = ShadowColor.A > 0.0f && !Appearance.ShadowOffset.IsZero();
+	const float Width = Geometry.GetLocalSize().X;
+
+	for (int32 LineIndex = 0; LineIndex < Text.Lines.Num(); LineIndex++)
+	{
+		const float LineWidth = Text.LineWidths[LineIndex];
+		FVector2D LinePosition(0.0f, Text.LineHeight * LineIndex);
+		if (Appearance.Justification == ETextJustify::Center)
+		{
+			LinePosition.X = (Width - LineWidth) * 0.5f;
+		}
+		else if (Appearance.Justification == ETextJustify::Right)
+		{
+			LinePosition.X = Width - LineWidth;
+		}
+
+		const FVector2D LineSize(LineWidth, Text.LineHeight);
+		if (bHasShadow)
+		{
+			FSlateDrawElement::MakeText(OutDrawElements, LayerId, Geometry.ToPaintGeometry(LinePosition + Appearance.ShadowOffset, LineSize), Text.Lines[LineIndex], Appearance.Font, ESlateDrawEffect::None, ShadowColor);
+		}
+
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId + 1, Geometry.ToPaintGeometry(LinePosition, LineSize), Text.Lines[LineIndex], Appearance.Font, ESlateDrawEffect::None, TextColor);
+	}
+
+	return LayerId + 1;
+}
+
+int32 SLightweightLayout::PaintLoadingIcon(const FGeometry& Geometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const
+{
+	if (LoadingWidgetSettings.LoadingIconType == ELoadingIconType::LIT_BatchedThrobber)
+	{
+		return BatchedThrobber.Paint(Geometry, CurrentTime, OutDrawElements, LayerId, InWidgetStyle);
+	}
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+
+	if (LoadingWidgetSettings.LoadingIconType == ELoadingIconType::LIT_CircularThrobber)
+	{
+		// Same as SCircularThrobber, the pieces go around the circle and grow until the last one is full size
+		const FCircularThrobberSettings& Throbber = LoadingWidgetSettings.CircularThrobberSettings;
+		const FSlateBrush* Brush = &Throbber.Image;
+		const FLinearColor Color = Brush->GetTint(InWidgetStyle) * Tint;
+		const FVector2D LocalOffset = (Geometry.GetLocalSize() - Brush->ImageSize) * 0.5f;
+		const float DeltaAngle = Throbber.NumberOfPieces > 0 ? 2.0f * PI / Throbber.NumberOfPieces : 0.0f;
+		const float Phase = Throbber.Period > 0.0f ? static_cast<float>(FMath::Fmod(CurrentTime, static_cast<double>(Throbber.Period)) / Throbber.Period) * 2.0f * PI : 0.0f;
+
+		for (int32 PieceIndex = 0; PieceIndex < Throbber.NumberOfPieces; PieceIndex++)
+		{
+			const float Angle = DeltaAngle * PieceIndex + Phase;
+			const FSlateLayoutTransform PieceTransform((PieceIndex + 1) / static_cast<float>(Throbber.NumberOfPieces), LocalOffset + LocalOffset * FVector2D(FMath::Sin(Angle), FMath::Cos(Angle)));
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, Geometry.ToPaintGeometry(Brush->ImageSize, PieceTransform), Brush, ESlateDrawEffect::None, Color);
+		}
+
+		return LayerId;
+	}
+
+	// Close to SThrobber, each piece pulses a little after the previous one
+	const FThrobberSettings& Throbber = LoadingWidgetSettings.ThrobberSettings;
+	const FSlateBrush* Brush = &Throbber.Image;
+	const FVector2D PieceSize = Brush->ImageSize;
+	const double PulseDuration = 1.5;
+	const double PieceDelay = 0.05;
+
+	for (int32 PieceIndex = 0; PieceIndex < Throbber.NumberOfPieces; PieceIndex++)
+	{
+		const double PieceTime = FMath::Max(CurrentTime - PieceDelay * PieceIndex, 0.0);
+		const float Value = FMath::Sin(PI * static_cast<float>(FMath::Fmod(PieceTime, PulseDuration) / PulseDuration));
+
+		const FVector2D Scale(Throbber.bAnimateHorizontally ? Value : 1.0f, Throbber.bAnimateVertically ? Value : 1.0f);
+		FLinearColor Color = Brush->GetTint(InWidgetStyle) * Tint;
+		Color.A *= Throbber.bAnimateOpacity ? Value : 1.0f;
+
+		const FVector2D Center(PieceSize.X * (PieceIndex + 0.5f), Geometry.GetLocalSize().Y * 0.5f);
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, Geometry.ToPaintGeometry(Center - PieceSize * Scale * 0.5f, PieceSize * Scale), Brush, ESlateDrawEffect::None, Color);
+	}
+
+	return LayerId;
+}
+
+int32 SLightweightLayout::PaintProgressBar(const FGeometry& Geometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const
+{
+	const FProgressBarSettings& ProgressBarSettings = LoadingWidgetSettings.ProgressBarSettings;
+
+	// Same as the progress bar widget, the progress is only read again once the update interval has passed
+	if (CurrentTime - LastProgressUpdateTime >= ProgressBarSettings.UpdateInterval)
+	{
+		LastProgressUpdateTime = CurrentTime;
+		DisplayedProgress = LoadingProgress->GetProgress();
+	}
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+	const FSlateBrush* BackgroundBrush = &ProgressBarSettings.Style.BackgroundImage;
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, Geometry.ToPaintGeometry(ArrangedProgressBar.Position, ArrangedProgressBar.Size), BackgroundBrush, ESlateDrawEffect::None, BackgroundBrush->GetTint(InWidgetStyle) * Tint);
+
+	// The bar stays empty until the progress is known
+	if (DisplayedProgress > 0.0f)
+	{
+		const FSlateBrush* FillBrush = &ProgressBarSettings.Style.FillImage;
+		const FVector2D FillSize(ArrangedProgressBar.Size.X * DisplayedProgress, ArrangedProgressBar.Size.Y);
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId + 1, Geometry.ToPaintGeometry(ArrangedProgressBar.Position, FillSize), FillBrush, ESlateDrawEffect::None,
+			FillBrush->GetTint(InWidgetStyle) * ProgressBarSettings.FillColorAndOpacity * Tint);
+	}
+
+	return LayerId + 1;
+}
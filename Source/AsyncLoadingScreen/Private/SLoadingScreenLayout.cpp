@@ -8,6 +8,24 @@
 
 #include "SLoadingScreenLayout.h"
 #include "Engine/UserInterfaceSettings.h"
+#include "LoadingScreenSettings.h"
+#include "SBackgroundWidget.h"
+#include "STipWidget.h"
+#include "SHorizontalLoadingWidget.h"
+#include "SVerticalLoadingWidget.h"
+#include "AsyncLoadingScreen.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "LoadingScreenTextureStreaming.h"
+
+DECLARE_CYCLE_STAT(TEXT("Layout OnPaint"), STAT_LayoutOnPaint, STATGROUP_AsyncLoadingScreen);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Layout Paint Elements"), STAT_LayoutPaintElements, STATGROUP_AsyncLoadingScreen);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Layout First Paint (ms)"), STAT_LayoutFirstPaint, STATGROUP_AsyncLoadingScreen);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Frame Rate Cap Sleep (ms)"), STAT_FrameRateCapSleep, STATGROUP_AsyncLoadingScreen);
+
+SLoadingScreenLayout::SLoadingScreenLayout()
+{
+	SnapshotDPIScaleSettings();
+}
 
 float SLoadingScreenLayout::PointSizeToSlateUnits(float PointSize)
 {
@@ -17,10 +35,299 @@ float SLoadingScreenLayout::PointSizeToSlateUnits(float PointSize)
 	return PixelSize;
 }
 
+void SLoadingScreenLayout::Rebind()
+{
+	// The UI scale settings may have changed since the last loading screen
+	SnapshotDPIScaleSettings();
+
+	if (BackgroundWidget.IsValid())
+	{
+		BackgroundWidget->Rebind();
+	}
+
+	if (TipWidget.IsValid())
+	{
+		TipWidget->Rebind();
+	}
+
+	if (LoadingWidget.IsValid())
+	{
+		LoadingWidget->Rebind();
+	}
+}
+
+void SLoadingScreenLayout::ReleaseResources()
+{
+	if (NumPaints > 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Layout painted %d frames, %.1f paint elements and %.3f ms per frame on average, static widgets %s."),
+			NumPaints, static_cast<double>(NumPaintElements) / NumPaints, FPlatformTime::ToMilliseconds64(PaintCycles) / NumPaints, bCacheStaticWidgets ? TEXT("cached") : TEXT("not cached"));
+
+		NumPaints = 0;
+		NumPaintElements = 0;
+		PaintCycles = 0;
+		FirstPaintTime = 0.0;
+		LastPaintTime = 0.0;
+		MaxPaintInterval = 0.0;
+	}
+
+	if (NumCappedFrames > 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loading thread slept %.3f s over %d frames to cap the frame rate at %.1f fps, %.1f fps when idle."),
+			FrameRateSleepTime, NumCappedFrames, MaxFrameRate, MaxIdleFrameRate > 0.0f ? MaxIdleFrameRate : MaxFrameRate);
+
+		FrameRateSleepTime = 0.0;
+		NumCappedFrames = 0;
+	}
+
+	if (BackgroundWidget.IsValid())
+	{
+		BackgroundWidget->ReleaseImage();
+	}
+
+	if (LoadingWidget.IsValid())
+	{
+		LoadingWidget->ReleaseImageSequence();
+	}
+}
+
+int32 SLoadingScreenLayout::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_LayoutOnPaint);
+
+	// Elements painted from cache aren't added to the uncached list, so this is what was actually painted this frame
+	const int32 ElementsBefore = OutDrawElements.GetUncachedDrawElements().Num();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const double PaintTime = FPlatformTime::Seconds();
+
+	const int32 MaxLayerId = PaintLayout(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	const int32 PaintElements = OutDrawElements.GetUncachedDrawElements().Num() - ElementsBefore;
+	SET_DWORD_STAT(STAT_LayoutPaintElements, PaintElements);
+
+	const uint64 FrameCycles = FPlatformTime::Cycles64() - StartCycles;
+	if (NumPaints == 0)
+	{
+		// The first frame shapes the text and rasterizes any glyph that wasn't prewarmed
+		const double FirstPaintMs = FPlatformTime::ToMilliseconds64(FrameCycles);
+		SET_FLOAT_STAT(STAT_LayoutFirstPaint, FirstPaintMs);
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("First frame of the layout painted in %.3f ms."), FirstPaintMs);
+		FirstPaintTime = PaintTime;
+	}
+	else
+	{
+		MaxPaintInterval = FMath::Max(MaxPaintInterval, PaintTime - LastPaintTime);
+	}
+	LastPaintTime = PaintTime;
+
+	NumPaints++;
+	NumPaintElements += PaintElements;
+	PaintCycles += FrameCycles;
+
+	return MaxLayerId;
+}
+
+SLoadingScreenLayout::FFrameStats SLoadingScreenLayout::GetFrameStats() const
+{
+	FFrameStats Stats;
+	Stats.NumFrames = NumPaints;
+	if (NumPaints > 0)
+	{
+		Stats.FirstPaintTime = FirstPaintTime;
+		Stats.AveragePaintTimeMs = FPlatformTime::ToMilliseconds64(PaintCycles) / NumPaints;
+		Stats.AverageFrameTimeMs = NumPaints > 1 ? (LastPaintTime - FirstPaintTime) * 1000.0 / (NumPaints - 1) : 0.0;
+		Stats.MaxFrameTimeMs = MaxPaintInterval * 1000.0;
+	}
+	return Stats;
+}
+
+int32 SLoadingScreenLayout::PaintLayout(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+bool SLoadingScreenLayout::IsAnimating() const
+{
+	return LoadingWidget.IsValid() && LoadingWidget->IsAnimating();
+}
+
+void SLoadingScreenLayout::SetMaxFrameRate(float InMaxFrameRate, float InMaxIdleFrameRate)
+{
+	MaxFrameRate = FMath::Max(InMaxFrameRate, 0.0f);
+	MaxIdleFrameRate = FMath::Max(InMaxIdleFrameRate, 0.0f);
+	LastFrameTime = 0.0;
+
+	if ((MaxFrameRate > 0.0f || MaxIdleFrameRate > 0.0f) && !bIsFrameRateTimerRegistered)
+	{
+		bIsFrameRateTimerRegistered = true;
+		RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingScreenLayout::LimitFrameRate));
+	}
+}
+
+EActiveTimerReturnType SLoadingScreenLayout::LimitFrameRate(double InCurrentTime, float InDeltaTime)
+{
+	// Never stall the game thread, it draws the loading screen itself when the movie player has no loading thread
+	if (IsInGameThread())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	if (MaxFrameRate <= 0.0f && MaxIdleFrameRate <= 0.0f)
+	{
+		bIsFrameRateTimerRegistered = false;
+		return EActiveTimerReturnType::Stop;
+	}
+
+	const float FrameRate = !IsAnimating() && MaxIdleFrameRate > 0.0f ? MaxIdleFrameRate : MaxFrameRate;
+	if (FrameRate <= 0.0f)
+	{
+		LastFrameTime = 0.0;
+		return EActiveTimerReturnType::Continue;
+	}
+
+	double CurrentTime = FPlatformTime::Seconds();
+	const double TimeToWait = LastFrameTime + 1.0 / FrameRate - CurrentTime;
+
+	// Nothing to hold back on the first frame or after a hitch
+	if (TimeToWait > 0.0 && LastFrameTime > 0.0)
+	{
+		FPlatformProcess::Sleep(static_cast<float>(TimeToWait));
+
+		const double SleepEndTime = FPlatformTime::Seconds();
+		SET_FLOAT_STAT(STAT_FrameRateCapSleep, (SleepEndTime - CurrentTime) * 1000.0);
+		FrameRateSleepTime += SleepEndTime - CurrentTime;
+		NumCappedFrames++;
+		CurrentTime = SleepEndTime;
+	}
+
+	LastFrameTime = CurrentTime;
+	return EActiveTimerReturnType::Continue;
+}
+
 float SLoadingScreenLayout::GetDPIScale() const
 {
-	const FVector2D& DrawSize = GetTickSpaceGeometry().ToPaintGeometry().GetLocalSize();
+	const FVector2D& DrawSize = GetTickSpaceGeometry().GetLocalSize();
 	const FIntPoint Size((int32)DrawSize.X, (int32)DrawSize.Y);
 
-	return GetDefault<UUserInterfaceSettings>()->GetDPIScaleBasedOnSize(Size);
+	if (Size != CachedDPIScaleSize)
+	{
+		CachedDPIScaleSize = Size;
+		CachedDPIScale = EvaluateDPIScale(Size);
+	}
+
+	return CachedDPIScale;
+}
+
+void SLoadingScreenLayout::SnapshotDPIScaleSettings()
+{
+	check(IsInGameThread());
+
+	const UUserInterfaceSettings* Settings = GetDefault<UUserInterfaceSettings>();
+	ApplicationScale = Settings->ApplicationScale;
+
+	if (const FRichCurve* Curve = Settings->UIScaleCurve.GetRichCurveConst())
+	{
+		DPIScaleCurve = *Curve;
+	}
+
+	switch (Settings->UIScaleRule)
+	{
+	case EUIScalingRule::ShortestSide:
+		DPIScaleAxis = EDPIScaleAxis::ShortestSide;
+		break;
+	case EUIScalingRule::LongestSide:
+		DPIScaleAxis = EDPIScaleAxis::LongestSide;
+		break;
+	case EUIScalingRule::Horizontal:
+		DPIScaleAxis = EDPIScaleAxis::Horizontal;
+		break;
+	case EUIScalingRule::Vertical:
+		DPIScaleAxis = EDPIScaleAxis::Vertical;
+		break;
+	default:
+		{
+			// Custom rules are objects, evaluate them now for the viewport size
+			DPIScaleAxis = EDPIScaleAxis::Fixed;
+			const FVector2D ViewportSize = FLoadingScreenTextureStreaming::GetViewportSize();
+			FixedDPIScale = Settings->GetDPIScaleBasedOnSize(FIntPoint((int32)ViewportSize.X, (int32)ViewportSize.Y));
+		}
+		break;
+	}
+
+	// Evaluate again on the next paint
+	CachedDPIScaleSize = FIntPoint(-1, -1);
+}
+
+float SLoadingScreenLayout::EvaluateDPIScale(const FIntPoint& Size) const
+{
+	int32 EvalPoint = 0;
+	switch (DPIScaleAxis)
+	{
+	case EDPIScaleAxis::ShortestSide:
+		EvalPoint = FMath::Min(Size.X, Size.Y);
+		break;
+	case EDPIScaleAxis::LongestSide:
+		EvalPoint = FMath::Max(Size.X, Size.Y);
+		break;
+	case EDPIScaleAxis::Horizontal:
+		EvalPoint = Size.X;
+		break;
+	case EDPIScaleAxis::Vertical:
+		EvalPoint = Size.Y;
+		break;
+	case EDPIScaleAxis::Fixed:
+	default:
+		return FixedDPIScale;
+	}
+
+	// Same as UUserInterfaceSettings::GetDPIScaleBasedOnSize
+	const float Scale = DPIScaleCurve.Eval((float)EvalPoint, 1.0f);
+	return FMath::Max(Scale * ApplicationScale, 0.01f);
+}
+
+TSharedRef<SWidget> SLoadingScreenLayout::ConstructBackgroundWidget(const FBackgroundSettings& Settings)
+{
+	return SAssignNew(BackgroundWidget, SBackgroundWidget, Settings)
+		.TextureLimits(RenderPlan->GetTextureLimits());
+}
+
+TSharedRef<SWidget> SLoadingScreenLayout::ConstructTipWidget(const FTipSettings& Settings)
+{
+	return SAssignNew(TipWidget, STipWidget, Settings);
+}
+
+TSharedRef<SWidget> SLoadingScreenLayout::ConstructLoadingWidget(const FLoadingWidgetSettings& Settings)
+{
+	if (Settings.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
+	{
+		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings)
+			.TextureLimits(RenderPlan->GetTextureLimits());
+	}
+	else
+	{
+		LoadingWidget = SNew(SVerticalLoadingWidget, Settings)
+			.TextureLimits(RenderPlan->GetTextureLimits());
+	}
+
+	return LoadingWidget.ToSharedRef();
+}
+
+TSharedRef<SWidget> SLoadingScreenLayout::ConstructStaticLayer(const TSharedRef<SWidget>& Content, const FALoadingScreenSettings& Settings)
+{
+	bCacheStaticWidgets = Settings.bCacheStaticWidgets;
+	if (!bCacheStaticWidgets)
+	{
+		return Content;
+	}
+
+	// The throbbers animate in OnPaint without invalidating, so the loading icon has to be painted every frame
+	if (LoadingWidget.IsValid())
+	{
+		LoadingWidget->SetLoadingIconVolatile(true);
+	}
+
+	return SNew(SInvalidationPanel)
+		[
+			Content
+		];
 }
@@ -11,31 +11,100 @@
 #include "Widgets/Images/SImage.h"
 #include "Slate/DeferredCleanupSlateBrush.h"
 #include "Widgets/Layout/SSpacer.h"
+#include "Widgets/SOverlay.h"
 #include "Engine/Texture2D.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CoreDelegates.h"
+#include "AsyncLoadingScreen.h"
+#include "LoadingScreenFlipbook.h"
+#include "LoadingScreenDeltaSequence.h"
+#include "LoadingScreenDeltaSequencePlayer.h"
+#include "LoadingScreenAnimatedImage.h"
+#include "LoadingScreenStreamingSequencePlayer.h"
+#include "IImageWrapperModule.h"
+#include "Misc/Paths.h"
+#include "LoadingScreenTextureStreaming.h"
+#include "SBatchedThrobber.h"
+#include "LoadingScreenProgress.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+DECLARE_CYCLE_STAT(TEXT("Construct Loading Icon"), STAT_ConstructLoadingIcon, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Request Image Sequence"), STAT_RequestImageSequence, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Image Sequence Loaded"), STAT_ImageSequenceLoaded, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Animate Image Sequence"), STAT_AnimateImageSequence, STATGROUP_AsyncLoadingScreen);
+DECLARE_CYCLE_STAT(TEXT("Update Progress Bar"), STAT_UpdateProgressBar, STATGROUP_AsyncLoadingScreen);
+
+namespace
+{
+	// Playback speed when neither FramesPerSecond nor Interval is set, matches the default Interval of 0.05 seconds
+	const float DefaultFramesPerSecond = 20.0f;
+}
+
+SLoadingWidget::~SLoadingWidget()
+{
+	ReleaseImageSequence();
+}
 
 EActiveTimerReturnType SLoadingWidget::AnimatingImageSequence(double InCurrentTime, float InDeltaTime)
 {	
-	if (CleanupBrushList.Num() > 1)
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_AnimateImageSequence);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	// Animated image files play at their own speed, the player decides when the next frame is due
+	if (bUseStreamingSequence)
 	{
-		if (bPlayReverse)
+		if (!StreamingSequencePlayer.IsValid())
 		{
-			ImageIndex--;
+			bIsActiveTimerRegistered = false;
+			return EActiveTimerReturnType::Stop;
 		}
-		else
+
+		if (StreamingSequencePlayer->Tick(InDeltaTime))
 		{
-			ImageIndex++;
+			IconImage->Invalidate(EInvalidateWidgetReason::Paint);
 		}
-		
-		if (ImageIndex >= CleanupBrushList.Num())
+		return EActiveTimerReturnType::Continue;
+	}
+
+	// Swap in the image sequence once it's streamed in
+	if (ApplyPendingImageSequence())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	const int32 NumFrames = GetNumImageSequenceFrames();
+	if (NumFrames > 1)
+	{
+		if (PlaybackStartTime < 0.0)
 		{
-			ImageIndex = 0;
+			PlaybackStartTime = InCurrentTime;
 		}
-		else if (ImageIndex < 0)
+
+		// Pick the frame from the elapsed time, if the loading thread hitched the frames in between are skipped
+		const double FramePosition = (InCurrentTime - PlaybackStartTime) * ImageSequenceFramesPerSecond;
+		const int64 FrameCount = static_cast<int64>(FramePosition);
+		int32 FrameIndex = static_cast<int32>(FrameCount % NumFrames);
+		int32 NextFrameIndex = (FrameIndex + 1) % NumFrames;
+		if (bPlayReverse)
 		{
-			ImageIndex = CleanupBrushList.Num() - 1;
+			FrameIndex = NumFrames - 1 - FrameIndex;
+			NextFrameIndex = NumFrames - 1 - NextFrameIndex;
 		}
 
-		StaticCastSharedRef<SImage>(LoadingIcon)->SetImage(CleanupBrushList[ImageIndex].IsValid() ? CleanupBrushList[ImageIndex]->GetSlateBrush() : nullptr);
+		if (FrameIndex != ImageIndex)
+		{
+			ImageIndex = FrameIndex;
+			SetImageSequenceFrame(ImageIndex);
+		}
+
+		if (CrossFadeImage.IsValid())
+		{
+			SetCrossFadeFrame(NextFrameIndex, static_cast<float>(FramePosition - FrameCount));
+		}
 
 		return EActiveTimerReturnType::Continue;
 	}	
@@ -57,33 +126,83 @@ SThrobber::EAnimation SLoadingWidget::GetThrobberAnimation(FThrobberSettings Thr
 
 void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_ConstructLoadingIcon);
+	LLM_SCOPE_LOADING_SCREEN();
+
 	if (Settings.LoadingIconType == ELoadingIconType::LIT_ImageSequence)
 	{
 		// Loading Widget is image sequence
-		if (Settings.ImageSequenceSettings.Images.Num() > 0)
+		const FImageSequenceSettings& ImageSequenceSettings = Settings.ImageSequenceSettings;
+		if (ImageSequenceSettings.Images.Num() > 0 || !ImageSequenceSettings.Flipbook.IsNull() || !ImageSequenceSettings.DeltaSequence.IsNull()
+			|| !ImageSequenceSettings.AnimatedImageFile.FilePath.IsEmpty())
 		{
-			CleanupBrushList.Empty();
-			ImageIndex = 0;
+			ImageSequenceScale = ImageSequenceSettings.Scale;
+			ImageSequenceScreenScale = ImageSequenceScale.GetAbsMax() * Settings.TransformScale.GetAbsMax() * FLoadingScreenTextureStreaming::GetViewportDPIScale();
+			ImageSequenceFramesPerSecond = ImageSequenceSettings.FramesPerSecond > 0.0f ? ImageSequenceSettings.FramesPerSecond
+				: (ImageSequenceSettings.Interval > 0.0f ? 1.0f / ImageSequenceSettings.Interval : DefaultFramesPerSecond);
+			bUseFlipbook = !ImageSequenceSettings.Flipbook.IsNull();
+			bUseDeltaSequence = !bUseFlipbook && !ImageSequenceSettings.DeltaSequence.IsNull();
+			bUseStreamingSequence = !bUseFlipbook && !bUseDeltaSequence && !ImageSequenceSettings.AnimatedImageFile.FilePath.IsEmpty();
 
-			FVector2D Scale = Settings.ImageSequenceSettings.Scale;
-
-			for (auto Image: Settings.ImageSequenceSettings.Images)
+			// Gather the images to request
+			ImageSequenceAssets.Empty();
+			if (bUseFlipbook)
+			{
+				ImageSequenceAssets.Add(ImageSequenceSettings.Flipbook.ToSoftObjectPath());
+			}
+			else if (bUseDeltaSequence)
+			{
+				ImageSequenceAssets.Add(ImageSequenceSettings.DeltaSequence.ToSoftObjectPath());
+			}
+			else if (bUseStreamingSequence)
+			{
+				const FString& FilePath = ImageSequenceSettings.AnimatedImageFile.FilePath;
+				StreamingSequenceFile = FPaths::IsRelative(FilePath) ? FPaths::Combine(FPaths::ProjectDir(), FilePath) : FilePath;
+				StreamingBufferFrames = ImageSequenceSettings.StreamingBufferFrames;
+			}
+			else
 			{
-				if (Image)
+				for (const TSoftObjectPtr<UTexture2D>& Image : ImageSequenceSettings.Images)
 				{
-					CleanupBrushList.Add(FDeferredCleanupSlateBrush::CreateBrush(Image, FVector2D(Image->GetSurfaceWidth() * Scale.X, Image->GetSurfaceHeight() * Scale.Y)));					
-				}				
+					if (!Image.IsNull())
+					{
+						ImageSequenceAssets.Add(Image.ToSoftObjectPath());
+					}
+				}
 			}
-		
-			// Create Image slate widget
-			LoadingIcon = SNew(SImage)
-				.Image(CleanupBrushList[ImageIndex]->GetSlateBrush());
 
-			// Register animated image sequence active timer event
-			if (!bIsActiveTimerRegistered)
+			// Create Image slate widget, the brush will be set when the images are streamed in
+			IconImage = SNew(SImage)
+				.Image(nullptr);
+
+			// The delta sequence and animated image file only have a single texture, there is no other frame to blend in
+			if (ImageSequenceSettings.bCrossFadeFrames && !bUseDeltaSequence && !bUseStreamingSequence)
 			{
-				bIsActiveTimerRegistered = true;
-				RegisterActiveTimer(Settings.ImageSequenceSettings.Interval, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingWidget::AnimatingImageSequence));
+				CrossFadeImage = SNew(SImage)
+					.Image(nullptr);
+
+				LoadingIcon = SNew(SOverlay)
+					+ SOverlay::Slot()
+					[
+						IconImage.ToSharedRef()
+					]
+					+ SOverlay::Slot()
+					[
+						CrossFadeImage.ToSharedRef()
+					];
+			}
+			else
+			{
+				LoadingIcon = IconImage.ToSharedRef();
+			}
+
+			if (bUseStreamingSequence)
+			{
+				StartStreamingSequence();
+			}
+			else
+			{
+				RequestImageSequence();
 			}
 		}
 		else
@@ -93,9 +212,16 @@ void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings
 		}
 
 	}
+	else if (Settings.LoadingIconType == ELoadingIconType::LIT_BatchedThrobber)
+	{
+		// Loading Widget is SBatchedThrobber
+		bIsThrobber = true;
+		LoadingIcon = SNew(SBatchedThrobber, Settings.BatchedThrobberSettings);
+	}
 	else if (Settings.LoadingIconType == ELoadingIconType::LIT_CircularThrobber)
 	{
 		// Loading Widget is SCircularThrobber
+		bIsThrobber = true;
 		LoadingIcon = SNew(SCircularThrobber)
 			.NumPieces(Settings.CircularThrobberSettings.NumberOfPieces)
 			.Period(Settings.CircularThrobberSettings.Period)
@@ -105,6 +231,7 @@ void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings
 	else
 	{
 		// Loading Widget is SThrobber
+		bIsThrobber = true;
 		LoadingIcon = SNew(SThrobber)
 			.NumPieces(Settings.ThrobberSettings.NumberOfPieces)
 			.Animate(GetThrobberAnimation(Settings.ThrobberSettings))
@@ -115,4 +242,552 @@ void SLoadingWidget::ConstructLoadingIcon(const FLoadingWidgetSettings& Settings
 	LoadingIcon.Get().SetRenderTransform(FSlateRenderTransform(FScale2D(Settings.TransformScale), Settings.TransformTranslation));
 	LoadingIcon.Get().SetRenderTransformPivot(Settings.TransformPivot);
 }
-	
\ No newline at end of file
+
+void SLoadingWidget::Rebind()
+{
+	if (ProgressBar.IsValid())
+	{
+		DisplayedProgress = -1.0f;
+		ProgressBar->SetPercent(TOptional<float>());
+	}
+
+	if (RemainingTimeText.IsValid())
+	{
+		DisplayedRemainingSeconds = INDEX_NONE;
+		RemainingTimeText->SetVisibility(EVisibility::Hidden);
+	}
+
+	if (ImageSequenceAssets.Num() > 0 && !ImageSequenceHandle.IsValid())
+	{
+		RequestImageSequence();
+	}
+	else if (bUseStreamingSequence && !StreamingSequencePlayer.IsValid())
+	{
+		StartStreamingSequence();
+	}
+}
+
+TSharedRef<SWidget> SLoadingWidget::ConstructProgressBar(const TSharedRef<SWidget>& Content, const FLoadingWidgetSettings& Settings)
+{
+	if (!Settings.bShowProgressBar)
+	{
+		return Content;
+	}
+
+	const FProgressBarSettings& ProgressBarSettings = Settings.ProgressBarSettings;
+	LoadingProgress = FAsyncLoadingScreenModule::Get().GetLoadingProgress();
+
+	// No percent shows the marquee until the progress is known
+	SAssignNew(ProgressBar, SProgressBar)
+		.Style(&ProgressBarSettings.Style)
+		.FillColorAndOpacity(ProgressBarSettings.FillColorAndOpacity)
+		.Percent(TOptional<float>());
+
+	// The loading thread only reads the progress and repaints the bar at the update interval
+	RegisterActiveTimer(ProgressBarSettings.UpdateInterval, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingWidget::UpdateProgressBar));
+
+	TSharedRef<SVerticalBox> Root = SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			Content
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		.Padding(0.0f, ProgressBarSettings.Space, 0.0f, 0.0f)
+		[
+			SNew(SBox)
+			.WidthOverride(ProgressBarSettings.Size.X)
+			.HeightOverride(ProgressBarSettings.Size.Y)
+			[
+				ProgressBar.ToSharedRef()
+			]
+		];
+
+	if (ProgressBarSettings.bShowRemainingTime)
+	{
+		// Hidden rather than collapsed, so the layout doesn't move when the time shows up
+		RemainingTimeFormat = ProgressBarSettings.RemainingTimeFormat;
+		Root->AddSlot()
+			.AutoHeight()
+			.HAlign(HAlign_Center)
+			.Padding(0.0f, ProgressBarSettings.Space, 0.0f, 0.0f)
+			[
+				SAssignNew(RemainingTimeText, STextBlock)
+				.Visibility(EVisibility::Hidden)
+				.ColorAndOpacity(Settings.Appearance.ColorAndOpacity)
+				.Font(Settings.Appearance.Font)
+				.ShadowOffset(Settings.Appearance.ShadowOffset)
+				.ShadowColorAndOpacity(Settings.Appearance.ShadowColorAndOpacity)
+				.Justification(Settings.Appearance.Justification)
+			];
+	}
+
+	return Root;
+}
+
+EActiveTimerReturnType SLoadingWidget::UpdateProgressBar(double InCurrentTime, float InDeltaTime)
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_UpdateProgressBar);
+
+	const float Progress = LoadingProgress->GetProgress();
+	if (Progress != DisplayedProgress)
+	{
+		DisplayedProgress = Progress;
+		ProgressBar->SetPercent(Progress >= 0.0f ? TOptional<float>(Progress) : TOptional<float>());
+	}
+
+	if (RemainingTimeText.IsValid())
+	{
+		// The text is only formatted again when the number of seconds changes
+		const float RemainingTime = LoadingProgress->GetRemainingTime();
+		const int32 RemainingSeconds = RemainingTime >= 0.0f ? FMath::CeilToInt(RemainingTime) : INDEX_NONE;
+		if (RemainingSeconds != DisplayedRemainingSeconds)
+		{
+			DisplayedRemainingSeconds = RemainingSeconds;
+			if (RemainingSeconds != INDEX_NONE)
+			{
+				FFormatNamedArguments Arguments;
+				Arguments.Add(TEXT("Seconds"), FText::AsNumber(RemainingSeconds));
+				RemainingTimeText->SetText(FText::Format(RemainingTimeFormat, Arguments));
+			}
+			RemainingTimeText->SetVisibility(RemainingSeconds != INDEX_NONE ? EVisibility::SelfHitTestInvisible : EVisibility::Hidden);
+		}
+	}
+
+	return EActiveTimerReturnType::Continue;
+}
+
+void SLoadingWidget::SetLoadingIconVolatile(bool bVolatile)
+{
+	LoadingIcon->ForceVolatile(bVolatile);
+}
+
+bool SLoadingWidget::IsAnimating() const
+{
+	if (!LoadingIcon->GetVisibility().IsVisible())
+	{
+		return false;
+	}
+
+	if (IconImage.IsValid())
+	{
+		return bUseStreamingSequence || GetNumImageSequenceFrames() > 1;
+	}
+
+	// The throbbers animate all the time, the spacer never does
+	return bIsThrobber;
+}
+
+void SLoadingWidget::RequestImageSequence()
+{
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_RequestImageSequence);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	CleanupBrushList.Empty();
+	FlipbookFrameRegions.Empty();
+	ImageIndex = 0;
+
+	bool bAllResident = true;
+	for (const FSoftObjectPath& ImageAsset : ImageSequenceAssets)
+	{
+		bAllResident &= ImageAsset.ResolveObject() != nullptr;
+	}
+
+	FStreamableManager& StreamableManager = FAsyncLoadingScreenModule::Get().GetStreamableManager();
+	bIsImageSequenceLoading = true;
+	if (bAllResident)
+	{
+		// Nothing to load, the handle completes right away and only keeps the resident images alive until the loading screen is gone
+		ImageSequenceHandle = StreamableManager.RequestSyncLoad(ImageSequenceAssets);
+		OnImageSequenceLoaded();
+	}
+	else
+	{
+		ImageSequenceHandle = StreamableManager.RequestAsyncLoad(ImageSequenceAssets,
+			FStreamableDelegate::CreateSP(this, &SLoadingWidget::OnImageSequenceLoaded), FStreamableManager::AsyncLoadHighPriority);
+
+		if (!ImageSequenceHandle.IsValid())
+		{
+			OnImageSequenceLoaded();
+		}
+		else if (!FlushUpdateHandle.IsValid())
+		{
+			// The streamable delegate is only called on the next game tick, which doesn't come before a blocking LoadMap is done.
+			// Poll the handle while the game thread flushes async loading as well, so the animation starts during the load
+			FlushUpdateHandle = FCoreDelegates::OnAsyncLoadingFlushUpdate.AddSP(this, &SLoadingWidget::OnAsyncLoadingFlushUpdate);
+		}
+	}
+	UpdateBrushCounter();
+
+	// Register animated image sequence active timer event
+	if (!bIsActiveTimerRegistered)
+	{
+		bIsActiveTimerRegistered = true;
+		// The frame to show is picked from the elapsed time either way, cross-fading needs every frame to blend smoothly
+		const float TimerPeriod = CrossFadeImage.IsValid() ? 0.0f : 1.0f / ImageSequenceFramesPerSecond;
+		RegisterActiveTimer(TimerPeriod, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingWidget::AnimatingImageSequence));
+	}
+}
+
+void SLoadingWidget::OnAsyncLoadingFlushUpdate()
+{
+	if (ImageSequenceHandle.IsValid() && ImageSequenceHandle->HasLoadCompleted())
+	{
+		OnImageSequenceLoaded();
+	}
+}
+
+void SLoadingWidget::StopPolling()
+{
+	if (FlushUpdateHandle.IsValid())
+	{
+		FCoreDelegates::OnAsyncLoadingFlushUpdate.Remove(FlushUpdateHandle);
+		FlushUpdateHandle.Reset();
+	}
+}
+
+void SLoadingWidget::OnImageSequenceLoaded()
+{
+	// Called by whichever of the flush update and the streamable delegate comes first
+	StopPolling();
+	if (!bIsImageSequenceLoading)
+	{
+		return;
+	}
+
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_ImageSequenceLoaded);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	TArray<UObject*> LoadedAssets;
+	if (ImageSequenceHandle.IsValid())
+	{
+		ImageSequenceHandle->GetLoadedAssets(LoadedAssets);
+	}
+
+	if (bUseFlipbook)
+	{
+		SetPendingFlipbook(LoadedAssets.Num() > 0 ? Cast<ULoadingScreenFlipbook>(LoadedAssets[0]) : nullptr);
+	}
+	else if (bUseDeltaSequence)
+	{
+		SetPendingDeltaSequence(LoadedAssets.Num() > 0 ? Cast<ULoadingScreenDeltaSequence>(LoadedAssets[0]) : nullptr);
+	}
+	else
+	{
+		TArray<UTexture2D*> Images;
+		for (UObject* LoadedAsset : LoadedAssets)
+		{
+			Images.Add(Cast<UTexture2D>(LoadedAsset));
+		}
+
+		SetPendingImageSequence(Images);
+	}
+
+	UpdateBrushCounter();
+}
+
+void SLoadingWidget::SetPendingImageSequence(const TArray<UTexture2D*>& Images)
+{
+	TArray<TSharedPtr<FDeferredCleanupSlateBrush>> BrushList;
+	ImageSequenceResourceSize = 0;
+
+	for (UTexture2D* Image : Images)
+	{
+		if (Image)
+		{
+			FLoadingScreenTextureStreaming::UpdateResidentMips(Image, ImageSequenceScreenScale, TextureLimits);
+			BrushList.Add(FDeferredCleanupSlateBrush::CreateBrush(Image, FVector2D(Image->GetSurfaceWidth() * ImageSequenceScale.X, Image->GetSurfaceHeight() * ImageSequenceScale.Y)));
+			ImageSequenceResourceSize += Image->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loaded %d image sequence frames, %.2f KB resident."), BrushList.Num(), ImageSequenceResourceSize / 1024.0f);
+
+	FScopeLock Lock(&PendingBrushListCS);
+	PendingBrushList = MoveTemp(BrushList);
+	bIsImageSequenceLoading = false;
+}
+
+void SLoadingWidget::SetPendingFlipbook(const ULoadingScreenFlipbook* Flipbook)
+{
+	FSlateBrush Brush;
+	TArray<FBox2D> FrameRegions;
+	ImageSequenceResourceSize = 0;
+
+	if (Flipbook && Flipbook->Atlas && Flipbook->GetNumFrames() > 0)
+	{
+		FLoadingScreenTextureStreaming::UpdateResidentMips(Flipbook->Atlas, ImageSequenceScreenScale, TextureLimits);
+		Brush.SetResourceObject(Flipbook->Atlas);
+		Brush.ImageSize = FVector2D(Flipbook->FrameSize.X * ImageSequenceScale.X, Flipbook->FrameSize.Y * ImageSequenceScale.Y);
+		FrameRegions = Flipbook->FrameRegions;
+		ImageSequenceResourceSize = Flipbook->Atlas->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loaded flipbook %s with %d frames, %.2f KB resident."), *Flipbook->GetName(), FrameRegions.Num(), ImageSequenceResourceSize / 1024.0f);
+
+		// The atlas has no mips and never streams, so the texture limits can't drop what isn't visible, the whole atlas stays resident
+		const int32 AtlasSize = FMath::Max(Flipbook->Atlas->GetSizeX(), Flipbook->Atlas->GetSizeY());
+		const bool bOverMaxResolution = TextureLimits.MaxResolution > 0 && AtlasSize > TextureLimits.MaxResolution;
+		if (TextureLimits.bLimitToScreenSize && (ImageSequenceScreenScale < 0.5f || bOverMaxResolution))
+		{
+			UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Flipbook %s has %dx%d frames drawn at %.0fx%.0f, its %dx%d atlas can't stream and stays resident in full (max resident resolution %d). Scale the source frames down and rebuild the atlas."),
+				*Flipbook->GetName(), Flipbook->FrameSize.X, Flipbook->FrameSize.Y, Flipbook->FrameSize.X * ImageSequenceScreenScale, Flipbook->FrameSize.Y * ImageSequenceScreenScale,
+				Flipbook->Atlas->GetSizeX(), Flipbook->Atlas->GetSizeY(), TextureLimits.MaxResolution);
+		}
+	}
+	else
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Image sequence flipbook failed to load or has no frames, did you build its atlas?"));
+	}
+
+	FScopeLock Lock(&PendingBrushListCS);
+	PendingFlipbookBrush = Brush;
+	PendingFlipbookFrameRegions = MoveTemp(FrameRegions);
+	bIsImageSequenceLoading = false;
+}
+
+void SLoadingWidget::SetPendingDeltaSequence(const ULoadingScreenDeltaSequence* DeltaSequence)
+{
+	TSharedPtr<FDeferredCleanupSlateBrush> Brush;
+	TSharedPtr<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe> Player;
+	ImageSequenceResourceSize = 0;
+
+	if (DeltaSequence && DeltaSequence->GetNumFrames() > 0 && DeltaSequence->FrameSize.GetMin() > 0)
+	{
+		const FIntPoint FrameSize = DeltaSequence->FrameSize;
+
+		// Single texture every frame is decoded into, the brush keeps it alive
+		UTexture2D* Texture = UTexture2D::CreateTransient(FrameSize.X, FrameSize.Y, PF_B8G8R8A8);
+		Texture->SRGB = true;
+		Texture->LODGroup = TEXTUREGROUP_UI;
+		Texture->UpdateResource();
+
+		Brush = FDeferredCleanupSlateBrush::CreateBrush(Texture, FVector2D(FrameSize.X * ImageSequenceScale.X, FrameSize.Y * ImageSequenceScale.Y));
+		Player = MakeShared<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe>(DeltaSequence, Texture);
+
+		// Start decoding the first frame right away
+		Player->RequestFrame(bPlayReverse ? DeltaSequence->GetNumFrames() - 1 : 0);
+
+		ImageSequenceResourceSize = static_cast<int64>(FrameSize.X) * FrameSize.Y * 4 + DeltaSequence->CompressedFrames.GetAllocatedSize();
+
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Loaded delta sequence %s with %d frames, %.2f KB resident."), *DeltaSequence->GetName(), DeltaSequence->GetNumFrames(), ImageSequenceResourceSize / 1024.0f);
+	}
+	else
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Image sequence delta sequence failed to load or has no frames, did you build it?"));
+	}
+
+	FScopeLock Lock(&PendingBrushListCS);
+	PendingDeltaSequenceBrush = Brush;
+	PendingDeltaSequencePlayer = Player;
+	bIsImageSequenceLoading = false;
+}
+
+bool SLoadingWidget::ApplyPendingImageSequence()
+{
+	FScopeLock Lock(&PendingBrushListCS);
+
+	if (PendingBrushList.Num() > 0)
+	{
+		CleanupBrushList = MoveTemp(PendingBrushList);
+		PendingBrushList.Reset();
+	}
+	else if (PendingFlipbookFrameRegions.Num() > 0)
+	{
+		FlipbookBrush = PendingFlipbookBrush;
+		FlipbookFrameRegions = MoveTemp(PendingFlipbookFrameRegions);
+		PendingFlipbookFrameRegions.Reset();
+		IconImage->SetImage(&FlipbookBrush);
+	}
+	else if (PendingDeltaSequencePlayer.IsValid())
+	{
+		DeltaSequenceBrush = PendingDeltaSequenceBrush;
+		DeltaSequencePlayer = PendingDeltaSequencePlayer;
+		PendingDeltaSequenceBrush.Reset();
+		PendingDeltaSequencePlayer.Reset();
+		IconImage->SetImage(DeltaSequenceBrush->GetSlateBrush());
+	}
+	else
+	{
+		// Keep waiting while the request is in flight
+		return bIsImageSequenceLoading;
+	}
+
+	ImageIndex = bPlayReverse ? GetNumImageSequenceFrames() - 1 : 0;
+	SetImageSequenceFrame(ImageIndex);
+
+	// Restart the playback clock, the first frame is shown for its full duration
+	PlaybackStartTime = -1.0;
+	CrossFadeIndex = INDEX_NONE;
+	UpdateBrushCounter();
+	INC_DWORD_STAT(STAT_BrushSwaps);
+	return true;
+}
+
+void SLoadingWidget::StartStreamingSequence()
+{
+	// Only the header is read here to size the texture, the frames are decoded on a worker thread
+	FIntPoint ImageSize;
+	if (!FLoadingScreenAnimatedImage::ReadImageSize(StreamingSequenceFile, ImageSize) || ImageSize.GetMin() <= 0)
+	{
+		UE_LOG(LogAsyncLoadingScreen, Warning, TEXT("Failed to read animated image file %s."), *StreamingSequenceFile);
+		return;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(ImageSize.X, ImageSize.Y, PF_B8G8R8A8);
+	Texture->SRGB = true;
+	Texture->LODGroup = TEXTUREGROUP_UI;
+	Texture->UpdateResource();
+
+	// The module has to be loaded on the game thread, the decoding itself is thread safe
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	StreamingSequenceBrush = FDeferredCleanupSlateBrush::CreateBrush(Texture, FVector2D(ImageSize.X * ImageSequenceScale.X, ImageSize.Y * ImageSequenceScale.Y));
+	StreamingSequencePlayer = MakeShared<FLoadingScreenStreamingSequencePlayer, ESPMode::ThreadSafe>(ImageWrapperModule, StreamingSequenceFile, Texture, StreamingBufferFrames);
+	StreamingSequencePlayer->Start();
+
+	IconImage->SetImage(StreamingSequenceBrush->GetSlateBrush());
+	UpdateBrushCounter();
+
+	// Tick every frame, each frame of the file has its own duration
+	if (!bIsActiveTimerRegistered)
+	{
+		bIsActiveTimerRegistered = true;
+		RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SLoadingWidget::AnimatingImageSequence));
+	}
+}
+
+int32 SLoadingWidget::GetNumImageSequenceFrames() const
+{
+	if (bUseFlipbook)
+	{
+		return FlipbookFrameRegions.Num();
+	}
+	else if (bUseDeltaSequence)
+	{
+		return DeltaSequencePlayer.IsValid() ? DeltaSequencePlayer->GetNumFrames() : 0;
+	}
+
+	return CleanupBrushList.Num();
+}
+
+void SLoadingWidget::SetImageSequenceFrame(int32 FrameIndex)
+{
+	if (bUseFlipbook)
+	{
+		// Only the UV region changes, the image keeps pointing at the same brush
+		FlipbookBrush.SetUVRegion(FlipbookFrameRegions[FrameIndex]);
+		IconImage->Invalidate(EInvalidateWidgetReason::Paint);
+	}
+	else if (bUseDeltaSequence)
+	{
+		// The frame is decoded into the same texture on a worker thread
+		DeltaSequencePlayer->RequestFrame(FrameIndex);
+		IconImage->Invalidate(EInvalidateWidgetReason::Paint);
+	}
+	else
+	{
+		IconImage->SetImage(CleanupBrushList[FrameIndex].IsValid() ? CleanupBrushList[FrameIndex]->GetSlateBrush() : nullptr);
+	}
+}
+
+void SLoadingWidget::SetCrossFadeFrame(int32 FrameIndex, float Alpha)
+{
+	if (FrameIndex != CrossFadeIndex)
+	{
+		CrossFadeIndex = FrameIndex;
+
+		if (bUseFlipbook)
+		{
+			// Second brush on the same atlas, pointing at the next frame
+			CrossFadeFlipbookBrush = FlipbookBrush;
+			CrossFadeFlipbookBrush.SetUVRegion(FlipbookFrameRegions[FrameIndex]);
+			CrossFadeImage->SetImage(&CrossFadeFlipbookBrush);
+			CrossFadeImage->Invalidate(EInvalidateWidgetReason::Paint);
+		}
+		else
+		{
+			CrossFadeImage->SetImage(CleanupBrushList[FrameIndex].IsValid() ? CleanupBrushList[FrameIndex]->GetSlateBrush() : nullptr);
+		}
+	}
+
+	CrossFadeImage->SetColorAndOpacity(FLinearColor(1.0f, 1.0f, 1.0f, Alpha));
+}
+
+void SLoadingWidget::ReleaseImageSequence()
+{
+	StopPolling();
+
+	if (StreamingSequencePlayer.IsValid())
+	{
+		const int64 AllocatedSize = StreamingSequencePlayer->GetAllocatedSize();
+
+		// Nothing may be uploaded to the texture once the brush lets go of it
+		StreamingSequencePlayer->Stop();
+		StreamingSequencePlayer.Reset();
+
+		IconImage->SetImage(nullptr);
+		StreamingSequenceBrush.Reset();
+
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Released animated image stream, %.2f KB of decoded frames freed."), AllocatedSize / 1024.0f);
+	}
+
+	if (ImageSequenceHandle.IsValid())
+	{
+		ImageSequenceHandle->ReleaseHandle();
+		ImageSequenceHandle.Reset();
+
+		{
+			FScopeLock Lock(&PendingBrushListCS);
+			PendingBrushList.Reset();
+			PendingFlipbookFrameRegions.Reset();
+			if (PendingDeltaSequencePlayer.IsValid())
+			{
+				PendingDeltaSequencePlayer->Stop();
+			}
+			PendingDeltaSequencePlayer.Reset();
+			PendingDeltaSequenceBrush.Reset();
+			bIsImageSequenceLoading = false;
+		}
+
+		// Nothing may be decoded into the texture once the brush lets go of it
+		if (DeltaSequencePlayer.IsValid())
+		{
+			DeltaSequencePlayer->Stop();
+			DeltaSequencePlayer.Reset();
+		}
+		DeltaSequenceBrush.Reset();
+
+		if (IconImage.IsValid())
+		{
+			IconImage->SetImage(nullptr);
+		}
+		if (CrossFadeImage.IsValid())
+		{
+			CrossFadeImage->SetImage(nullptr);
+			CrossFadeIndex = INDEX_NONE;
+		}
+		CleanupBrushList.Empty();
+		FlipbookFrameRegions.Empty();
+		FlipbookBrush = FSlateBrush();
+
+		UE_LOG(LogAsyncLoadingScreen, Log, TEXT("Released image sequence frames, %.2f KB can be reclaimed by the next garbage collection."), ImageSequenceResourceSize / 1024.0f);
+		ImageSequenceResourceSize = 0;
+	}
+
+	UpdateBrushCounter();
+}
+
+void SLoadingWidget::UpdateBrushCounter()
+{
+	// The pending brushes are written on the game thread, the lock is recursive so this can be called while it's held
+	FScopeLock Lock(&PendingBrushListCS);
+
+	// The flipbook brushes are plain brushes on the atlas, they count as one each
+	const int32 NumBrushes = CleanupBrushList.Num() + PendingBrushList.Num()
+		+ (FlipbookFrameRegions.Num() > 0 ? 1 : 0) + (PendingFlipbookFrameRegions.Num() > 0 ? 1 : 0)
+		+ (DeltaSequenceBrush.IsValid() ? 1 : 0) + (PendingDeltaSequenceBrush.IsValid() ? 1 : 0)
+		+ (StreamingSequenceBrush.IsValid() ? 1 : 0);
+	BrushCounter.Set(NumBrushes);
+}
@@ -10,33 +10,34 @@
 #include "LoadingScreenSettings.h"
 #include "Widgets/Layout/SSafeZone.h"
 #include "Widgets/Layout/SDPIScaler.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSpacer.h"
-#include "SHorizontalLoadingWidget.h"
-#include "SVerticalLoadingWidget.h"
-#include "SBackgroundWidget.h"
-#include "STipWidget.h"
+#include "LoadingScreenTrace.h"
 
-void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FSidebarLayoutSettings& LayoutSettings)
+DECLARE_CYCLE_STAT(TEXT("Sidebar Layout Construct"), STAT_SidebarLayoutConstruct, STATGROUP_AsyncLoadingScreen);
+
+void SSidebarLayout::Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan)
 {
+	SCOPE_LOADING_SCREEN_CYCLE_COUNTER(STAT_SidebarLayoutConstruct);
+	LLM_SCOPE_LOADING_SCREEN();
+
+	RenderPlan = InRenderPlan;
+	const FALoadingScreenSettings& Settings = InRenderPlan->GetSettings();
+	const FSidebarLayoutSettings& LayoutSettings = InRenderPlan->GetSidebar();
+
 	// Root widget and background
 	TSharedRef<SOverlay> Root = SNew(SOverlay)
 		+ SOverlay::Slot()
 		.HAlign(HAlign_Fill)
 		.VAlign(VAlign_Fill)
 		[
-			SNew(SBackgroundWidget, Settings.Background)
+			ConstructBackgroundWidget(Settings.Background)
 		];
 
-	// Placeholder for loading widget
-	TSharedRef<SWidget> LoadingWidget = SNullWidget::NullWidget;
-	if (Settings.LoadingWidget.LoadingWidgetType == ELoadingWidgetType::LWT_Horizontal)
-	{
-		LoadingWidget = SNew(SHorizontalLoadingWidget, Settings.LoadingWidget);
-	}
-	else
-	{
-		LoadingWidget = SNew(SVerticalLoadingWidget, Settings.LoadingWidget);
-	}
+	// Construct loading widget
+	ConstructLoadingWidget(Settings.LoadingWidget);
 	
 
 	TSharedRef<SVerticalBox> VerticalBox = SNew(SVerticalBox);
@@ -48,7 +49,7 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(LayoutSettings.LoadingWidgetAlignment.HorizontalAlignment)
 			.VAlign(LayoutSettings.LoadingWidgetAlignment.VerticalAlignment)
 			[
-				LoadingWidget
+				LoadingWidget.ToSharedRef()
 			];
 		
 		// Add SSpacer at middle
@@ -67,7 +68,7 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(LayoutSettings.TipAlignment.HorizontalAlignment)
 			.VAlign(LayoutSettings.TipAlignment.VerticalAlignment)
 			[
-				SNew(STipWidget, Settings.TipWidget)
+				ConstructTipWidget(Settings.TipWidget)
 			];
 	}
 	else
@@ -78,7 +79,7 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(LayoutSettings.TipAlignment.HorizontalAlignment)
 			.VAlign(LayoutSettings.TipAlignment.VerticalAlignment)
 			[
-				SNew(STipWidget, Settings.TipWidget)
+				ConstructTipWidget(Settings.TipWidget)
 			];
 
 		// Add SSpacer at middle
@@ -97,7 +98,7 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 			.HAlign(LayoutSettings.LoadingWidgetAlignment.HorizontalAlignment)
 			.VAlign(LayoutSettings.LoadingWidgetAlignment.VerticalAlignment)
 			[
-				LoadingWidget
+				LoadingWidget.ToSharedRef()
 			];
 	}
 
@@ -167,6 +168,6 @@ void SSidebarLayout::Construct(const FArguments& InArgs, const FALoadingScreenSe
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		ConstructStaticLayer(Root, Settings)
 	];
 }
@@ -9,33 +9,39 @@
 #include "STipWidget.h"
 #include "LoadingScreenSettings.h"
 #include "Widgets/Text/STextBlock.h"
-#include "AsyncLoadingScreenLibrary.h"
+#include "AsyncLoadingScreen.h"
 
 void STipWidget::Construct(const FArguments& InArgs, const FTipSettings& Settings)
 {
 	if (Settings.TipText.Num() > 0)
 	{
-		int32 TipIndex = FMath::RandRange(0, Settings.TipText.Num() - 1);
-		
-		if (Settings.bSetDisplayTipTextManually == true)
-		{			
-			if (Settings.TipText.IsValidIndex(UAsyncLoadingScreenLibrary::GetDisplayTipTextIndex()))
-			{
-				TipIndex = UAsyncLoadingScreenLibrary::GetDisplayTipTextIndex();
-			}
-		}
+		TipTexts = Settings.TipText;
+		bSetDisplayTipTextManually = Settings.bSetDisplayTipTextManually;
 
 		ChildSlot
 		[
-			SNew(STextBlock)		
+			SAssignNew(TipTextBlock, STextBlock)
 			.ColorAndOpacity(Settings.Appearance.ColorAndOpacity)
 			.Font(Settings.Appearance.Font)
 			.ShadowOffset(Settings.Appearance.ShadowOffset)
 			.ShadowColorAndOpacity(Settings.Appearance.ShadowColorAndOpacity)
 			.Justification(Settings.Appearance.Justification)
 			.WrapTextAt(Settings.TipWrapAt)
-			.Text(Settings.TipText[TipIndex])			
+			.Text(TipTexts[GetTipIndex()])
 		];
 		
 	}
 }
+
+void STipWidget::Rebind()
+{
+	if (TipTextBlock.IsValid())
+	{
+		TipTextBlock->SetText(TipTexts[GetTipIndex()]);
+	}
+}
+
+int32 STipWidget::GetTipIndex() const
+{
+	return FAsyncLoadingScreenModule::Get().PickTipTextIndex(TipTexts.Num(), bSetDisplayTipTextManually);
+}
@@ -22,6 +22,7 @@ void SVerticalLoadingWidget::Construct(const FArguments& InArgs, const FLoadingW
 	TSharedRef<SVerticalBox> Root = SNew(SVerticalBox);
 
 	// Construct Loading Icon Widget
+	TextureLimits = InArgs._TextureLimits;
 	ConstructLoadingIcon(Settings);
 
 	EVisibility LoadingTextVisibility;
@@ -116,6 +117,6 @@ void SVerticalLoadingWidget::Construct(const FArguments& InArgs, const FLoadingW
 	// Add root to this widget
 	ChildSlot
 	[
-		Root
+		ConstructProgressBar(Root, Settings)
 	];
 }
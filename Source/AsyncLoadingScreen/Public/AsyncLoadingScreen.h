@@ -9,8 +9,22 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+#include "LoadingScreenStats.h"
 
 struct FALoadingScreenSettings;
+struct FEarlyStartupSplashSettings;
+struct FStreamableManager;
+struct FStreamableHandle;
+class SLoadingScreenLayout;
+class FLoadingScreenTextPrewarmer;
+class FLoadingScreenProgress;
+class FLoadingScreenLoadTimeModel;
+class FLoadingScreenLoadTimeComparison;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAsyncLoadingScreen, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("AsyncLoadingScreen"), STATGROUP_AsyncLoadingScreen, STATCAT_Advanced);
 
 class FAsyncLoadingScreenModule : public IModuleInterface
 {
@@ -56,6 +70,68 @@ public:
 		return FModuleManager::Get().IsModuleLoaded("AsyncLoadingScreen");
 	}
 
+	/**
+	 * Streamable manager used to asynchronously load the loading screen assets, so we never block the game thread right before a level load
+	 */
+	FStreamableManager& GetStreamableManager();
+
+	/**
+	 * Progress of the level load behind the current loading screen, read by the progress bar on the Slate loading thread
+	 */
+	TSharedRef<FLoadingScreenProgress, ESPMode::ThreadSafe> GetLoadingProgress() const;
+
+	/**
+	 * Asynchronously loads the background and loading icon images of the default loading screen ahead of opening a new level,
+	 * so the loading screen shows up without any blocking load. The assets stay resident until the next loading screen is gone.
+	 * The fonts are already resident with the settings, once the images are loaded the font cache loads their face data and
+	 * rasterizes the glyphs of the tips and loading text over the next game thread ticks. That part isn't asynchronous, a lazily
+	 * loaded font face is read from disk on the tick that first shapes a text with it.
+	 *
+	 * @param BackgroundIndex Index of the background to display on the next loading screen. If the index is not valid, it's picked now the same way the loading screen would.
+	 * @param TipTextIndex Index of the tip text to display on the next loading screen. If the index is not valid, it's picked now the same way the loading screen would.
+	 * @param OnComplete Called on the game thread when all the assets are resident.
+	 * @return Handle of the load request, invalid if there's nothing to load
+	 */
+	TSharedPtr<FStreamableHandle> PreloadLoadingScreenAssets(int32 BackgroundIndex = -1, int32 TipTextIndex = -1, FSimpleDelegate OnComplete = FSimpleDelegate());
+
+	/**
+	 * Picks the background to display: the one picked by PreloadLoadingScreenAssets, then the one set manually, otherwise a random one
+	 */
+	int32 PickBackgroundIndex(int32 NumImages, bool bSetDisplayBackgroundManually) const;
+
+	/**
+	 * Picks the tip text to display: the one picked by PreloadLoadingScreenAssets, then the one set manually, otherwise a random one
+	 */
+	int32 PickTipTextIndex(int32 NumTipTexts, bool bSetDisplayTipTextManually) const;
+
+	/**
+	 * Statistics of the last loading screen, they're also appended to Saved/Profiling/AsyncLoadingScreen.csv
+	 */
+	const FLoadingScreenStats& GetLastLoadingScreenStats() const { return LastLoadingScreenStats; }
+
+	/**
+	 * Construct the widget overlay for the layout selected in the loading screen settings
+	 */
+	TSharedRef<SLoadingScreenLayout> ConstructLayout(const FALoadingScreenSettings& LoadingScreenSettings) const;
+
+	/**
+	 * Gathers the assets the current or next loading screen needs, the ones a memory budget is enforced on
+	 */
+	void GatherSessionAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
+	/**
+	 * Travels between the maps with every loading screen configuration and compares the load times, see FLoadingScreenLoadTimeComparison
+	 *
+	 * @param MapNames Maps to travel to, in order
+	 * @param NumRuns Number of times each configuration travels to every map
+	 */
+	void StartLoadTimeComparison(const TArray<FString>& MapNames, int32 NumRuns);
+
+	/**
+	 * Stops the running load time comparison and reports what was measured so far
+	 */
+	void StopLoadTimeComparison();
+
 private:
 	/**
 	 * Loading screen callback, it won't be called if we've already explicitly setup the loading screen
@@ -67,8 +143,79 @@ private:
 	 */
 	void SetupLoadingScreen(const FALoadingScreenSettings& LoadingScreenSettings);
 
+	/**
+	 * Setup the UObject-free splash shown during early startup
+	 */
+	void SetupEarlyStartupSplash(const FEarlyStartupSplashSettings& SplashSettings);
+
+	/**
+	 * Loading screen callback, called when the loading screen is gone
+	 */
+	void OnLoadingScreenFinished();
+
+	/**
+	 * Queues the texts of the default loading screen for prewarming once the engine is initialized
+	 */
+	void OnPostEngineInit();
+
+	/**
+	 * Works out the statistics of the loading screen that just finished and appends them to the CSV history
+	 */
+	void RecordLoadingScreenStats();
+
+	/**
+	 * Hash of the loading screen settings and the selected layout settings, the cached widget overlay is only reused if it matches
+	 */
+	uint32 GetLayoutSettingsHash(const FALoadingScreenSettings& LoadingScreenSettings) const;
+
 	/**
 	 * Shuffle the movies list
 	 */
 	void ShuffleMovies(TArray<FString>& MoviesList);
+
+	/**
+	 * Adds the background and loading icon images of the loading screen to the list of assets to preload, all the backgrounds if the index is INDEX_NONE
+	 */
+	void GatherLoadingScreenAssets(const FALoadingScreenSettings& LoadingScreenSettings, int32 BackgroundIndex, TArray<FSoftObjectPath>& OutAssets) const;
+
+	// Streamable manager for loading screen assets
+	TSharedPtr<FStreamableManager> StreamableManager;
+
+	// Rasterizes the glyphs of the tip and loading texts ahead of the loading screen
+	TSharedPtr<FLoadingScreenTextPrewarmer> TextPrewarmer;
+
+	// Samples the level load progress while the loading screen is shown
+	TSharedPtr<FLoadingScreenProgress, ESPMode::ThreadSafe> LoadingProgress;
+
+	// Load times of the past loading screens of each map, predicts the progress of the next ones
+	TSharedPtr<FLoadingScreenLoadTimeModel> LoadTimeModel;
+
+	// Load time comparison, its configuration overrides the default loading screen while it runs
+	TSharedPtr<FLoadingScreenLoadTimeComparison> LoadTimeComparison;
+
+	// Widget overlay kept to be reused by the next loading screen
+	TSharedPtr<SLoadingScreenLayout> CachedLayout;
+	// Settings hash of the cached widget overlay
+	uint32 CachedLayoutHash = 0;
+
+	// Handle of the preloaded assets, released when the next loading screen is gone
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+	// Background and tip text picked by PreloadLoadingScreenAssets, the tip is also picked by SetupLoadingScreen to prewarm it
+	int32 PreloadedBackgroundIndex = INDEX_NONE;
+	int32 PreloadedTipTextIndex = INDEX_NONE;
+
+	// When the loading screen was set up and the frame rate caps it was shown with, to compare load times against the caps
+	double LoadingScreenStartTime = 0.0;
+	float LoadingScreenMaxFrameRate = 0.0f;
+	float LoadingScreenMaxIdleFrameRate = 0.0f;
+	float LoadingScreenMinimumDisplayTime = 0.0f;
+
+	// Whether the early startup splash replaced the startup loading screen, checked once the splash is gone
+	bool bShowingEarlyStartupSplash = false;
+
+	// Widget overlay of the current loading screen, its frame statistics are recorded when it's gone
+	TSharedPtr<SLoadingScreenLayout> ActiveLayout;
+
+	// Statistics of the last loading screen
+	FLoadingScreenStats LastLoadingScreenStats;
 };
@@ -10,6 +10,8 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Engine/LatentActionManager.h"
+#include "LoadingScreenStats.h"
 #include "AsyncLoadingScreenLibrary.generated.h"
 
 /**
@@ -49,6 +51,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Async Loading Screen")
 	static void SetDisplayMovieIndex(int32 MovieIndex);
 
+	/**
+	 * Load the background and loading icon images of the loading screen in the background before opening a new level, so the loading screen doesn't have to wait for them.
+	 * The glyphs of the tips and loading text are cached on the following game thread ticks.
+	 * The picked background and tip text will be displayed on the next loading screen.
+	 *
+	 * @param BackgroundIndex Valid index of the Background in "Images" array in Background setting. If the index is not valid, then it will pick the background like the loading screen would.
+	 * @param TipTextIndex Valid index of the text in "TipText" array in Tip Widget setting. If the index is not valid, then it will pick the text like the loading screen would.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "Async Loading Screen", meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject"))
+	static void PreloadLoadingScreenAssets(UObject* WorldContextObject, FLatentActionInfo LatentInfo, int32 BackgroundIndex = -1, int32 TipTextIndex = -1);
+
+	/**
+	 * Get what the last loading screen cost: time to its first frame, how long it was shown, how much of it was spent loading and waiting
+	 * on the "MinimumLoadingScreenDisplayTime", and the frame times of the widget overlay. "IsValid" is false until a loading screen is gone.
+	 **/
+	UFUNCTION(BlueprintPure, Category = "Async Loading Screen")
+	static FLoadingScreenStats GetLastLoadingScreenStats();
 
 	static inline int32 GetDisplayBackgroundIndex() { return DisplayBackgroundIndex; }
 	static inline int32 GetDisplayTipTextIndex() { return DisplayTipTextIndex; }
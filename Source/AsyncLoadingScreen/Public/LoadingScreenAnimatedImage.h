@@ -0,0 +1,54 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IImageWrapperModule;
+
+/**
+ * Sequential decoder of animated image files (GIF, APNG) used as streaming loading icons. Frames are composited on a canvas
+ * the size of the image, so each decoded frame depends on the previous ones and they can only be decoded in order.
+ * WebP isn't supported, the engine doesn't ship a decoder for it.
+ */
+class FLoadingScreenAnimatedImage
+{
+public:
+	virtual ~FLoadingScreenAnimatedImage() {}
+
+	/** Reads only the header of a GIF or PNG file to get its canvas size, cheap enough for the game thread */
+	static bool ReadImageSize(const FString& FilePath, FIntPoint& OutSize);
+
+	/** Reads and parses a GIF or PNG/APNG file. The image wrapper module must have been loaded on the game thread beforehand */
+	static TUniquePtr<FLoadingScreenAnimatedImage> Open(IImageWrapperModule& ImageWrapperModule, const FString& FilePath);
+
+	/** Size of the canvas in pixels */
+	FIntPoint GetSize() const { return Size; }
+
+	/** Number of frames in the animation */
+	virtual int32 GetNumFrames() const = 0;
+
+	/**
+	 * Decodes the next frame and returns the whole canvas as BGRA8 pixels, starting over after the last frame.
+	 * OutDuration is how long the frame is shown, in seconds.
+	 */
+	virtual bool DecodeNextFrame(TArray<uint8>& OutPixels, float& OutDuration) = 0;
+
+	/** Bytes held by the decoder: the file and the canvases */
+	int64 GetAllocatedSize() const { return FileData.GetAllocatedSize() + Canvas.GetAllocatedSize() + PreviousCanvas.GetAllocatedSize(); }
+
+protected:
+	FIntPoint Size = FIntPoint::ZeroValue;
+	// The whole file, frames are decoded from it on demand
+	TArray<uint8> FileData;
+	// Composited frame and the copy restored by "dispose to previous" frames
+	TArray<uint8> Canvas;
+	TArray<uint8> PreviousCanvas;
+	int32 NextFrame = 0;
+};
@@ -0,0 +1,127 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Layout/Margin.h"
+#include "Widgets/Layout/SScaleBox.h"
+#include "Templates/Atomic.h"
+#include "LoadingScreenImageDecoder.h"
+#include "LoadingScreenTrace.h"
+#include "LoadingScreenTextureStreaming.h"
+
+struct FBackgroundSettings;
+struct FStreamableHandle;
+struct FSlateBrush;
+struct FSlateDynamicImageBrush;
+class FDeferredCleanupSlateBrush;
+class UTexture2D;
+
+/**
+ * Picks a background image and loads it for the widget owning the loader. Textures are streamed in with the module's streamable manager
+ * and image files are decoded on a worker thread, either way the brush is created on the game thread, also while it's blocked flushing
+ * async loading in LoadMap. The owner swaps it in from an active timer on the Slate loading thread by calling Update, until IsRequestDone.
+ */
+class FLoadingScreenBackgroundLoader : public TSharedFromThis<FLoadingScreenBackgroundLoader, ESPMode::ThreadSafe>
+{
+public:
+	FLoadingScreenBackgroundLoader(const FBackgroundSettings& Settings, const FLoadingScreenTextureLimits& InTextureLimits);
+	~FLoadingScreenBackgroundLoader();
+
+	/** Number of background images and image files to choose from */
+	int32 GetNumImages() const { return Images.Num() + ImageFiles.Num(); }
+
+	/** Picks the background image and requests it, the previous one has to be released first */
+	void Request();
+
+	/** Cancels the request and releases the brush, the owner must stop showing it first */
+	void Release();
+
+	/** Swaps the brush of a finished request in, returns true if GetBrush changed */
+	bool Update();
+
+	/** Whether there's nothing left to swap in, whether the request succeeded or not */
+	bool IsRequestDone() const;
+
+	/** Brush of the loaded background image, null until one has been swapped in */
+	const FSlateBrush* GetBrush() const;
+
+private:
+	/** Decodes the image file on a worker thread, scaled down to the screen size */
+	void RequestImageFile(const FString& FilePath);
+
+	/** Called on the game thread when the background texture has been streamed in */
+	void OnImageLoaded();
+
+	/** Polls the texture request while the game thread is blocked flushing async loading, e.g. in LoadMap */
+	void OnAsyncLoadingFlushUpdate();
+
+	/** Ticker callback polling the image file decode while the engine is ticking */
+	bool Tick(float DeltaTime);
+
+	/** Creates the brush on the game thread once the image file has been decoded */
+	void CreateFileImageBrush();
+
+	/** Unbinds the flush update and ticker polling */
+	void StopPolling();
+
+	/** Creates the brush for the background texture, it will be swapped in on the next update */
+	void SetPendingImage(UTexture2D* LoadingImage);
+
+	/** Reports the background brushes held to the live brush counter */
+	void UpdateBrushCounter();
+
+private:
+	// The background images to choose from
+	TArray<FSoftObjectPath> Images;
+	// The background image files to choose from, absolute paths
+	TArray<FString> ImageFiles;
+	bool bSetDisplayBackgroundManually = false;
+	// How the image is stretched and padded, used to work out which mips are visible
+	EStretch::Type ImageStretch = EStretch::ScaleToFit;
+	FMargin ImagePadding;
+	FLoadingScreenTextureLimits TextureLimits;
+
+	// Brush of the background texture or of the decoded background image file, only one of them is set
+	TSharedPtr<FDeferredCleanupSlateBrush> ImageBrush;
+	TSharedPtr<FSlateDynamicImageBrush> FileImageBrush;
+	// Handle of the background texture async load request
+	TSharedPtr<FStreamableHandle> ImageHandle;
+	// Time the background image was requested, in seconds
+	double RequestTime = 0.0;
+	// Bound to FCoreDelegates::OnAsyncLoadingFlushUpdate while a request is in flight, and to the core ticker while an image file is decoding
+	FDelegateHandle FlushUpdateHandle;
+	FDelegateHandle TickerHandle;
+
+	// Brush created on the game thread, waiting to be swapped in by the Slate loading thread
+	TSharedPtr<FDeferredCleanupSlateBrush> PendingImageBrush;
+	// Whether the background texture request has finished, whether it succeeded or not
+	bool bImageRequestDone = true;
+	mutable FCriticalSection PendingImageBrushCS;
+
+	/** State shared with the decoding task, so the loader can move on to another image while it's still decoding */
+	struct FFileDecodeState
+	{
+		FLoadingScreenDecodedImage Image;
+		FString FilePath;
+		// Created on the game thread from the decoded pixels, handed over when bDone is set
+		TSharedPtr<FSlateDynamicImageBrush> Brush;
+		// Set by the decoding task once Image is written
+		TAtomic<bool> bDecoded { false };
+		TAtomic<bool> bDone { false };
+		TAtomic<bool> bCanceled { false };
+	};
+
+	TSharedPtr<FFileDecodeState, ESPMode::ThreadSafe> FileDecodeState;
+	// The same state, only touched by the game thread while it polls for the decoded pixels
+	TSharedPtr<FFileDecodeState, ESPMode::ThreadSafe> PolledFileDecodeState;
+
+	FLoadingScreenBrushCounter BrushCounter;
+};
@@ -0,0 +1,112 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "LoadingScreenDeltaSequence.generated.h"
+
+class UTexture2D;
+
+/**
+ * One frame of a delta sequence: the dirty rects that changed since the previous frame, their pixels compressed in a single block
+ */
+USTRUCT()
+struct ASYNCLOADINGSCREEN_API FLoadingScreenDeltaFrame
+{
+	GENERATED_BODY()
+
+	/** Keyframes cover the whole frame and don't depend on the previous frames */
+	UPROPERTY(VisibleAnywhere, Category = "Frame")
+	bool bKeyframe = false;
+
+	/** Rects that changed since the previous frame, their BGRA8 pixels are stored one after another, row by row */
+	UPROPERTY(VisibleAnywhere, Category = "Frame")
+	TArray<FIntRect> DirtyRects;
+
+	/** Offset of the compressed pixels in the compressed frame stream */
+	UPROPERTY(VisibleAnywhere, Category = "Frame")
+	int32 CompressedOffset = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Frame")
+	int32 CompressedSize = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = "Frame")
+	int32 UncompressedSize = 0;
+};
+
+/**
+ * Image sequence stored as keyframes plus per-frame dirty rect deltas. The loading icon decodes it incrementally on a worker thread
+ * into a single texture, so only one frame and the compressed stream are resident instead of a texture per frame.
+ */
+UCLASS(BlueprintType)
+class ASYNCLOADINGSCREEN_API ULoadingScreenDeltaSequence : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Size of a frame in pixels. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Delta Sequence")
+	FIntPoint FrameSize = FIntPoint::ZeroValue;
+
+	/** The frame table. */
+	UPROPERTY(VisibleAnywhere, Category = "Delta Sequence")
+	TArray<FLoadingScreenDeltaFrame> Frames;
+
+	/** Compressed pixels of all frames, see FLoadingScreenDeltaFrame. Serialized in bulk, not as a property. */
+	TArray<uint8> CompressedFrames;
+
+#if WITH_EDITORONLY_DATA
+	/** 
+	 * Folder that contains the source images, e.g. /AsyncLoadingScreen/Default/Mannequin/RunImages. The images are sorted by the number at the end of their names.
+	 * Ignored if Source Frames is not empty.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Source", meta = (ContentDir))
+	FDirectoryPath SourceFolder;
+
+	/** Source images of the sequence. All frames must have the same size. */
+	UPROPERTY(EditAnywhere, Category = "Source")
+	TArray<TSoftObjectPtr<UTexture2D>> SourceFrames;
+
+	/** A keyframe is stored every this many frames, which bounds the work to seek backwards when the sequence is played in reverse. */
+	UPROPERTY(EditAnywhere, Category = "Source", meta = (ClampMin = "1"))
+	int32 KeyframeInterval = 30;
+
+	/** Size of the tiles the frames are compared in, smaller tiles give tighter dirty rects but more of them. */
+	UPROPERTY(EditAnywhere, Category = "Source", meta = (ClampMin = "4", ClampMax = "256"))
+	int32 TileSize = 16;
+#endif
+
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	/** Number of frames in the sequence */
+	int32 GetNumFrames() const { return Frames.Num(); }
+
+	/** Index of the closest keyframe at or before the frame */
+	int32 GetKeyframeIndex(int32 FrameIndex) const;
+
+	/**
+	 * Decompresses the frame and writes its dirty rects into a full frame BGRA8 buffer.
+	 * Pixels outside of the dirty rects are left untouched. Safe to call from any thread.
+	 */
+	bool DecodeFrame(int32 FrameIndex, uint8* FramePixels) const;
+
+#if WITH_EDITOR
+	/** Encodes the source images into keyframes and dirty rect deltas. */
+	UFUNCTION(CallInEditor, Category = "Source")
+	void BuildSequence();
+
+	/** Decodes every frame back and compares it with the source frames, the cooker runs it on every sequence it saves */
+	bool VerifySequence(FString& OutError) const;
+
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+#endif
+};
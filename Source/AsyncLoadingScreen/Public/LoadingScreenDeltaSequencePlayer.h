@@ -0,0 +1,53 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+
+class ULoadingScreenDeltaSequence;
+class UTexture2D;
+
+/**
+ * Plays a delta sequence into a single texture. Frames are decoded on a worker thread and only their dirty rects are uploaded.
+ * The sequence and the texture must outlive the player until Stop() is called.
+ */
+class FLoadingScreenDeltaSequencePlayer : public TSharedFromThis<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe>
+{
+public:
+	FLoadingScreenDeltaSequencePlayer(const ULoadingScreenDeltaSequence* InSequence, UTexture2D* InTexture);
+
+	/** Number of frames in the sequence */
+	int32 GetNumFrames() const;
+
+	/** Requests the frame to be shown. If a frame is still being decoded, only the latest requested frame is decoded after it. */
+	void RequestFrame(int32 FrameIndex);
+
+	/** Stops decoding and waits for the frame in flight, no frame is decoded afterwards */
+	void Stop();
+
+private:
+	/** Decodes frames on the worker thread until the requested frame is shown */
+	void DecodeRequestedFrames();
+
+	/** Decodes the frame and uploads it to the texture, from the displayed frame if it's the next one, otherwise from its keyframe */
+	void DecodeFrame(int32 FrameIndex);
+
+private:
+	const ULoadingScreenDeltaSequence* Sequence;
+	UTexture2D* Texture;
+
+	TAtomic<int32> RequestedFrame { INDEX_NONE };
+	TAtomic<int32> DisplayedFrame { INDEX_NONE };
+	TAtomic<bool> bIsDecoding { false };
+	TAtomic<bool> bIsStopped { false };
+	// Held while a frame is decoded, so Stop() can wait for it
+	FCriticalSection DecodeCS;
+};
@@ -0,0 +1,65 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "LoadingScreenFlipbook.generated.h"
+
+class UTexture2D;
+
+/**
+ * Image sequence packed into a single atlas texture. The loading icon animates by changing the UV region of one brush
+ * instead of switching between a texture per frame.
+ */
+UCLASS(BlueprintType)
+class ASYNCLOADINGSCREEN_API ULoadingScreenFlipbook : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** The atlas texture that contains all frames. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flipbook")
+	UTexture2D* Atlas = nullptr;
+
+	/** Size of a single frame in pixels. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flipbook")
+	FIntPoint FrameSize = FIntPoint::ZeroValue;
+
+	/** The UV region of each frame in the atlas. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flipbook")
+	TArray<FBox2D> FrameRegions;
+
+#if WITH_EDITORONLY_DATA
+	/** 
+	 * Folder that contains the source images, e.g. /AsyncLoadingScreen/Default/Mannequin/RunImages. The images are sorted by the number at the end of their names.
+	 * Ignored if Source Frames is not empty.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Source", meta = (ContentDir))
+	FDirectoryPath SourceFolder;
+
+	/** Source images of the sequence. All frames must have the same size. */
+	UPROPERTY(EditAnywhere, Category = "Source")
+	TArray<TSoftObjectPtr<UTexture2D>> SourceFrames;
+
+	/** Empty space in pixels between frames in the atlas, avoids bleeding of neighbour frames when filtering. */
+	UPROPERTY(EditAnywhere, Category = "Source", meta = (ClampMin = "0", ClampMax = "16"))
+	int32 FramePadding = 2;
+#endif
+
+	/** Number of frames in the flipbook */
+	int32 GetNumFrames() const { return FrameRegions.Num(); }
+
+#if WITH_EDITOR
+	/** Packs the source images into the atlas texture and regenerates the frame region table. */
+	UFUNCTION(CallInEditor, Category = "Source")
+	void BuildAtlas();
+#endif
+};
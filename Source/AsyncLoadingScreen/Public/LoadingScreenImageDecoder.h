@@ -0,0 +1,48 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IImageWrapperModule;
+
+/**
+ * Raw BGRA8 pixels of a decoded image file
+ */
+struct FLoadingScreenDecodedImage
+{
+	TArray<uint8> Pixels;
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	bool IsValid() const { return Size.X > 0 && Size.Y > 0 && Pixels.Num() == Size.X * Size.Y * 4; }
+};
+
+/**
+ * Decodes loose PNG/JPEG files without touching the UObject system, so it can be used before the engine is up
+ */
+struct FLoadingScreenImageDecoder
+{
+	/** Finds the PNG and JPEG files in the directory, sorted by name */
+	static void FindImageFiles(const FString& Directory, TArray<FString>& OutFiles);
+
+	/**
+	 * Reads and decodes the image file into BGRA8 pixels. Safe to call from any thread,
+	 * but the image wrapper module must have been loaded on the game thread beforehand.
+	 */
+	static bool DecodeImageFile(IImageWrapperModule& ImageWrapperModule, const FString& FilePath, FLoadingScreenDecodedImage& OutImage);
+
+	/** Size of the image once it's scaled down by the given scale, the image is never scaled up */
+	static FIntPoint GetDownscaledSize(const FIntPoint& Size, float Scale);
+
+	/**
+	 * Box filters the image down to the target size. Rows are resampled in parallel and each
+	 * pixel is accumulated as a vector of its four channels.
+	 */
+	static void Downscale(const FLoadingScreenDecodedImage& Source, const FIntPoint& TargetSize, FLoadingScreenDecodedImage& OutImage);
+};
@@ -0,0 +1,114 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "LoadingScreenSettings.h"
+
+class UWorld;
+
+/**
+ * Measures what the loading screen costs the real level loads. The maps are traveled to over and over with no loading screen, with the
+ * movies only, with the widget overlay of every layout and with the default one at a few frame rate caps, and the load times of each configuration are compared in the log and in
+ * Saved/Profiling/AsyncLoadingScreenLoadTimes.csv. The configurations take turns on every travel, after an unmeasured warm-up pass.
+ * A load is timed from PreLoadMap to PostLoadMapWithWorld. The game thread stall is the time it spent blocked flushing async loading
+ * during the load, and the overlay time is what the widget overlay spent painting on the Slate loading thread.
+ */
+class FLoadingScreenLoadTimeComparison
+{
+public:
+	FLoadingScreenLoadTimeComparison(const TArray<FString>& InMapNames, int32 InNumRuns);
+	~FLoadingScreenLoadTimeComparison();
+
+	/** Starts traveling, returns false if there's no game world to travel from */
+	bool Start();
+
+	/** Stops traveling and reports what was measured so far */
+	void Stop();
+
+	/** Whether the maps are still being traveled to */
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	/** Loading screen the current configuration shows, unset when there's no comparison running */
+	const FALoadingScreenSettings* GetLoadingScreenOverride() const;
+
+private:
+	/** Loading screen settings the maps are traveled to with */
+	struct FConfiguration
+	{
+		FString Name;
+		FALoadingScreenSettings Settings;
+		bool bShowsWidgetOverlay = false;
+	};
+
+	/** One timed load */
+	struct FSample
+	{
+		FString Configuration;
+		FString MapName;
+		double WallTime = 0.0;
+		double StallTime = 0.0;
+		int32 NumSyncLoads = 0;
+		double OverlayTime = 0.0;
+	};
+
+	enum class EState : uint8
+	{
+		Ready,
+		Traveling,
+		Loading,
+		Settling,
+	};
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* World);
+
+	/** Ticker callback traveling to the next map once the previous loading screen is gone */
+	bool Tick(float DeltaTime);
+
+	/** Travels to the map of the current step */
+	bool TravelToNextMap();
+
+	/** Whether the current step only warms the caches up and isn't measured */
+	bool IsWarmUpStep() const;
+
+	/** Configuration and map of the current step */
+	int32 GetConfigurationIndex() const;
+	const FString& GetMapName() const;
+
+	/** Logs the mean and standard deviation of each configuration and writes the samples to the CSV file */
+	void Report() const;
+
+	/** Configurations the comparison goes through, built from the default loading screen */
+	static TArray<FConfiguration> MakeConfigurations();
+
+private:
+	TArray<FConfiguration> Configurations;
+	TArray<FString> MapNames;
+	int32 NumRuns = 0;
+
+	// Travels done so far, the warm-up ones included, the configuration changes on every travel after them
+	int32 Step = 0;
+	int32 NumWarmUpSteps = 0;
+	EState State = EState::Ready;
+	double StateStartTime = 0.0;
+
+	// Values when the current load started
+	double LoadStartTime = 0.0;
+	double LoadStartFlushTime = 0.0;
+	uint32 LoadStartSyncLoadCount = 0;
+	FSample CurrentSample;
+
+	TArray<FSample> Samples;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle TickerHandle;
+};
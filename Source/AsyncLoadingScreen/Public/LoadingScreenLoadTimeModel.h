@@ -0,0 +1,105 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/**
+ * When the milestones of a load happen, in seconds since the loading screen setup, negative if unknown
+ */
+struct FLoadingScreenLoadMilestones
+{
+	float PreLoadMapTime = -1.0f;
+	float PostLoadMapTime = -1.0f;
+	float FirstFrameTime = -1.0f;
+	float Duration = -1.0f;
+};
+
+/**
+ * History of the loading screen sessions of each map, kept in Saved/AsyncLoadingScreen/LoadTimes.csv.
+ * Every session records when the map load started, when the world was loaded, when it ticked its first frame and when the loading screen
+ * was gone, relative to the loading screen setup. The times are smoothed over the past runs, so the next loading screen of the map can
+ * predict its progress and remaining time even while the engine is blocked in LoadMap and reports nothing.
+ * The first frame is only a milestone when the loading screen outlasts PostLoadMapWithWorld, i.e. with bAllowEngineTick or bWaitForManualStop.
+ * Otherwise the movie player ends the loading screen before the world ticks, and the first frame is recorded as unknown.
+ */
+class FLoadingScreenLoadTimeModel
+{
+public:
+	FLoadingScreenLoadTimeModel();
+	~FLoadingScreenLoadTimeModel();
+
+	/** Starts timing a loading screen session, called when the loading screen is set up */
+	void BeginSession();
+
+	/** Stops timing the session, and folds it into the history of its map if the map is known */
+	void EndSession();
+
+	/** Smoothed milestones of the loading screen of the map, all negative if the map has no history */
+	FLoadingScreenLoadMilestones GetExpectedMilestones(const FString& MapName) const;
+
+	/** Map loaded by the current session, empty if no map load was seen */
+	const FString& GetSessionMapName() const { return SessionMapName; }
+
+	/** When the world of the current session was loaded, in FPlatformTime::Seconds, negative if it wasn't loaded yet */
+	double GetSessionPostLoadMapTime() const { return PostLoadMapTime >= 0.0f ? SessionStartTime + PostLoadMapTime : -1.0; }
+
+	/** Called when a map load starts, the expected duration of the map is known from here on */
+	DECLARE_EVENT_OneParam(FLoadingScreenLoadTimeModel, FOnMapLoadStarted, const FString& /*MapName*/);
+	FOnMapLoadStarted& OnMapLoadStarted() { return MapLoadStartedEvent; }
+
+private:
+	/** Smoothed milestones of a map, in seconds since the loading screen setup */
+	struct FLoadTimeRecord
+	{
+		int32 NumSessions = 0;
+		float PreLoadMapTime = 0.0f;
+		float PostLoadMapTime = 0.0f;
+		// Negative if the latest session ended before the first frame
+		float FirstFrameTime = 0.0f;
+		float Duration = 0.0f;
+	};
+
+	/** Drops the session without recording it, e.g. when its map load showed no loading screen */
+	void ResetSession();
+
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* World);
+	void OnBeginFrame();
+
+	/** Reads the history file */
+	void Load();
+
+	/** Writes the history file */
+	void Save() const;
+
+	/** Seconds since the session began */
+	float GetSessionTime() const;
+
+	/** Path of the history file */
+	static FString GetFilePath();
+
+private:
+	TMap<FString, FLoadTimeRecord> Records;
+
+	// Milestones of the current session, negative until they happen
+	double SessionStartTime = -1.0;
+	FString SessionMapName;
+	float PreLoadMapTime = -1.0f;
+	float PostLoadMapTime = -1.0f;
+	float FirstFrameTime = -1.0f;
+
+	FOnMapLoadStarted MapLoadStartedEvent;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle BeginFrameHandle;
+};
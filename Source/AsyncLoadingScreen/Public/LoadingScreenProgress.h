@@ -0,0 +1,98 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "Containers/Ticker.h"
+
+class UWorld;
+struct FLoadingScreenLoadMilestones;
+
+/**
+ * Progress of the level load behind the loading screen.
+ * The game thread samples the async loading percentage of the map package while the loading screen is shown, from the ticker and
+ * while async loading is flushed, and publishes it in a single atomic value the Slate loading thread reads without any lock.
+ * When the milestones of the map are known from past runs, the progress is also predicted along a piecewise curve through them: the
+ * setup, the map load, the wait for the first frame and the rest of the loading screen each get the share of the bar they took before.
+ * Every phase eases out towards its expected end and the next one starts from where the milestone actually happened, which keeps the
+ * bar moving while the engine is blocked in LoadMap and doesn't report anything, without drifting when one phase runs long.
+ */
+class FLoadingScreenProgress
+{
+public:
+	FLoadingScreenProgress();
+	~FLoadingScreenProgress();
+
+	/** Starts sampling the progress for a new loading screen, called on the game thread */
+	void Start();
+
+	/** Marks the load as complete and stops sampling, called on the game thread */
+	void Stop();
+
+	/** Sets when the milestones of the load are expected, the duration is negative if they aren't known. Safe to call from any thread */
+	void SetExpectedMilestones(const FLoadingScreenLoadMilestones& Milestones);
+
+	/** Progress between zero and one, negative while it isn't known yet. Safe to call from any thread */
+	float GetProgress() const;
+
+	/** Expected time left in seconds, negative if it isn't known. Safe to call from any thread */
+	float GetRemainingTime() const;
+
+private:
+	/** Remembers which map is about to be loaded, the map load phase starts */
+	void OnPreLoadMap(const FString& MapName);
+
+	/** The world is loaded, waits for its first frame */
+	void OnPostLoadMap(UWorld* World);
+
+	/** The world ticked its first frame, the last phase starts */
+	void OnBeginFrame();
+
+	/** Moves on to the phase, from the time elapsed. Called on the game thread */
+	void SetPhase(int32 Phase);
+
+	/** Expected milestones in seconds, one knot per phase boundary from zero to the duration. False if they aren't known */
+	bool GetKnots(float* OutKnots) const;
+
+	/** Called on the game thread while async loading is flushed, the engine doesn't tick then */
+	void OnAsyncLoadingFlushUpdate();
+
+	/** Ticker callback, used when the engine keeps ticking under the loading screen */
+	bool Tick(float DeltaTime);
+
+	/** Samples the async loading percentage of the map package, at most once per sample interval */
+	void Sample();
+
+	/** Seconds since the progress started */
+	float GetElapsedTime() const;
+
+private:
+	// Progress of the map package in ten-thousandths, negative while unknown
+	TAtomic<int32> Progress;
+	// Expected milestones in milliseconds, the pre load map, post load map, first frame and the duration, negative while unknown
+	TAtomic<int32> ExpectedMilestonesMs[4];
+	// Current phase in the high bits and the millisecond it started at in the low bits, so they're read together
+	TAtomic<int64> PhaseState;
+	// When the progress started
+	TAtomic<uint64> StartCycles;
+
+	// Package of the map being loaded
+	FName PackageName;
+	// Whether the package has been seen in the async loading queue
+	bool bPackageSeen = false;
+	bool bIsSampling = false;
+	double LastSampleTime = 0.0;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle FlushUpdateHandle;
+	FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,64 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LoadingScreenSettings.h"
+#include "LoadingScreenTrace.h"
+#include "LoadingScreenTextureStreaming.h"
+
+class FDeferredCleanupSlateBrush;
+class FLoadingScreenRenderPlan;
+
+typedef TSharedRef<const FLoadingScreenRenderPlan, ESPMode::ThreadSafe> FLoadingScreenRenderPlanRef;
+
+/**
+ * Immutable snapshot of the loading screen settings and the selected layout settings, taken on the game thread when the loading screen is set up.
+ * The widget overlay is constructed from it and keeps it alive, so the brushes, fonts and texts the Slate loading thread paints never point into
+ * the settings object, which may be edited or reloaded while the loading screen is shown. The objects used by the brushes are referenced by the
+ * plan itself, so they can't be garbage collected while the overlay paints them.
+ */
+class FLoadingScreenRenderPlan
+{
+public:
+	/** Copies the settings, has to be called on the game thread */
+	static FLoadingScreenRenderPlanRef Create(const FALoadingScreenSettings& InSettings, const ULoadingScreenSettings& InLayoutSettings);
+
+	/** The loading screen settings */
+	const FALoadingScreenSettings& GetSettings() const { return Settings; }
+
+	/** The layout settings, only the selected layout is meant to be used */
+	const FClassicLayoutSettings& GetClassic() const { return Classic; }
+	const FCenterLayoutSettings& GetCenter() const { return Center; }
+	const FLetterboxLayoutSettings& GetLetterbox() const { return Letterbox; }
+	const FSidebarLayoutSettings& GetSidebar() const { return Sidebar; }
+	const FDualSidebarLayoutSettings& GetDualSidebar() const { return DualSidebar; }
+
+	/** Texture memory limits the widgets stream their textures in with */
+	const FLoadingScreenTextureLimits& GetTextureLimits() const { return TextureLimits; }
+
+private:
+	FLoadingScreenRenderPlan() = default;
+
+	/** Keeps the resource object of the brush alive as long as the plan */
+	void ReferenceBrushResource(const FSlateBrush& Brush);
+
+private:
+	FALoadingScreenSettings Settings;
+	FClassicLayoutSettings Classic;
+	FCenterLayoutSettings Center;
+	FLetterboxLayoutSettings Letterbox;
+	FSidebarLayoutSettings Sidebar;
+	FDualSidebarLayoutSettings DualSidebar;
+	FLoadingScreenTextureLimits TextureLimits;
+
+	// Deferred cleanup brushes reference their resource objects and release them safely from any thread
+	TArray<TSharedRef<FDeferredCleanupSlateBrush>> BrushResourceReferences;
+	FLoadingScreenBrushCounter BrushCounter;
+};
@@ -13,9 +13,13 @@
 #include "MoviePlayer.h"
 #include "Widgets/Layout/SScaleBox.h"
 #include "Styling/SlateBrush.h"
+#include "Styling/SlateTypes.h"
 #include "Framework/Text/TextLayout.h"
 #include "LoadingScreenSettings.generated.h"
 
+class ULoadingScreenFlipbook;
+class ULoadingScreenDeltaSequence;
+
 
 /** 
  * Asynce Loading Screen Layouts
@@ -60,7 +64,9 @@ enum class ELoadingIconType : uint8
 	/** SCircularThrobber widget */
 	LIT_CircularThrobber UMETA(DisplayName = "Circular Throbber"),
 	/** Animated images */
-	LIT_ImageSequence UMETA(DisplayName = "Image Sequence")
+	LIT_ImageSequence UMETA(DisplayName = "Image Sequence"),
+	/** Circular throbber painted as a single batch of vertices */
+	LIT_BatchedThrobber UMETA(DisplayName = "Batched Throbber")
 };
 
 /** Loading Widget type */
@@ -162,25 +168,138 @@ struct FCircularThrobberSettings
 	FSlateBrush Image;
 };
 
+USTRUCT(BlueprintType)
+struct FBatchedThrobberSettings
+{
+	GENERATED_BODY()
+
+	/** How many pieces there are */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance, meta = (ClampMin = "1", ClampMax = "64", UIMin = "1", UIMax = "64"))
+	int32 NumberOfPieces = 8;
+
+	/** The amount of time for a full circle (in seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance, meta = (ClampMin = "0", UIMin = "0"))
+	float Period = 0.75f;
+
+	/** The radius of the circle */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	float Radius = 64.0f;
+
+	/** Should the pieces shrink towards the tail? */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	bool bAnimateScale = true;
+
+	/** Should the pieces fade out towards the tail? */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	bool bAnimateOpacity = false;
+
+	/** Image to use for each segment of the throbber, it must be an image brush */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	FSlateBrush Image;
+};
+
+USTRUCT(BlueprintType)
+struct FProgressBarSettings
+{
+	GENERATED_BODY()
+
+	/** Background and fill images of the bar */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	FProgressBarStyle Style;
+
+	/** Color and opacity of the fill image */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	FLinearColor FillColorAndOpacity = FLinearColor::White;
+
+	/** Size of the bar */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	FVector2D Size = FVector2D(320.0f, 8.0f);
+
+	/** Empty space between the loading icon and text, and the bar */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	float Space = 8.0f;
+
+	/**
+	 * Time in seconds between updates of the bar. The progress is sampled on the game thread either way,
+	 * the bar only repaints when this much time has passed and the progress has changed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance, meta = (UIMin = "0", UIMax = "1", ClampMin = "0"))
+	float UpdateInterval = 0.1f;
+
+	/**
+	 * Show the expected time left under the bar, with the loading text appearance. The time is predicted from the past loads of the level,
+	 * so nothing is shown the first time a level is loaded. The lightweight layout doesn't show it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	bool bShowRemainingTime = false;
+
+	/** Text of the time left, {Seconds} is replaced with the number of seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Appearance)
+	FText RemainingTimeFormat = NSLOCTEXT("AsyncLoadingScreen", "RemainingTimeFormat", "About {Seconds} s left");
+};
+
 USTRUCT(BlueprintType)
 struct FImageSequenceSettings
 {
 	GENERATED_BODY()
 
-	/** An array of images for animating the loading icon.*/
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (AllowedClasses = "Texture2D"))
-	TArray<UTexture2D*> Images;
+	/**
+	 * An array of images for animating the loading icon. The images are loaded asynchronously when the loading screen is shown
+	 * and released when it's gone, so they don't stay in memory for the whole session.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	TArray<TSoftObjectPtr<UTexture2D>> Images;
+
+	/**
+	 * A flipbook that packs the image sequence into a single atlas texture. If set, the loading icon is animated from the flipbook
+	 * instead of the "Images" array, which only needs one texture load and no texture switch between frames.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	TSoftObjectPtr<ULoadingScreenFlipbook> Flipbook;
+
+	/**
+	 * A delta sequence that stores the image sequence as keyframes and the rects that change between frames. If set and there's no "Flipbook",
+	 * the loading icon is decoded frame by frame into a single texture, which keeps about one frame resident.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	TSoftObjectPtr<ULoadingScreenDeltaSequence> DeltaSequence;
+
+	/**
+	 * An animated GIF or APNG file streamed as the loading icon, relative to the project directory. Used if there's no "Flipbook" or "Delta Sequence".
+	 * Frames are decoded in the background a few at a time, so long animations don't need more memory. WebP files aren't supported.
+	 * The file has to be staged with "Additional Non-Asset Directories to Copy", it always plays forward at the speed stored in the file.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (RelativeToGameDir))
+	FFilePath AnimatedImageFile;
+
+	/** Number of decoded frames of the "Animated Image File" kept ahead of playback. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (ClampMin = "1", ClampMax = "32", UIMin = "1", UIMax = "32"))
+	int32 StreamingBufferFrames = 4;
 
 	/** Scale of the images.*/
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
 	FVector2D Scale = FVector2D(1.0f, 1.0f);
 
 	/**
-	 * Time in second to update the images, the smaller value the faster of the animation. A zero value will update the images every frame.
+	 * Time in second to update the images, the smaller value the faster of the animation. A zero value plays the images at 20 frames per second.
 	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (UIMax = 1.00, UIMin = 0.00, ClampMin = "0", ClampMax = "1"))
 	float Interval = 0.05f;
 
+	/**
+	 * Playback speed of the image sequence in frames per second, overrides Interval when greater than zero.
+	 * The frame is picked from the elapsed time, so frames are skipped rather than slowed down when the loading thread hitches.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting", meta = (UIMax = 60.00, UIMin = 0.00, ClampMin = "0"))
+	float FramesPerSecond = 0.0f;
+
+	/**
+	 * Blend each frame into the next one by the time elapsed between them, smooths out low frame rate sequences on high refresh displays.
+	 * Only used by Images and Flipbook, the delta sequence and animated image file have a single texture to draw.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	bool bCrossFadeFrames = false;
+
 	/** Play the image sequence in reverse.*/
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
 	bool bPlayReverse = false;
@@ -198,6 +317,13 @@ struct ASYNCLOADINGSCREEN_API FBackgroundSettings
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background", meta = (AllowedClasses = "Texture2D"))
 	TArray<FSoftObjectPath> Images;
 
+	/**
+	 * PNG or JPEG files displayed like the "Images", e.g. seasonal backgrounds shipped outside of the pak files. Relative paths are relative to the project directory.
+	 * They're decoded on a worker thread and scaled down to the screen size, their indices come after the ones of the "Images" array.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background", meta = (RelativeToGameDir))
+	TArray<FFilePath> ImageFiles;
+
 	// The scaling type to apply to images.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background")
 	TEnumAsByte<EStretch::Type> ImageStretch = EStretch::ScaleToFit;
@@ -216,6 +342,9 @@ struct ASYNCLOADINGSCREEN_API FBackgroundSettings
 	 */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Background")
 	bool bSetDisplayBackgroundManually = false;
+
+	/** Number of backgrounds to choose from, assets and image files */
+	int32 GetNumBackgrounds() const { return Images.Num() + ImageFiles.Num(); }
 };
 
 /**
@@ -272,6 +401,10 @@ struct ASYNCLOADINGSCREEN_API FLoadingWidgetSettings
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
 	FCircularThrobberSettings CircularThrobberSettings;
 
+	/** Batched Throbber settings. Ignore this if you don't choose the 'Batched Throbber' icon type*/
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
+	FBatchedThrobberSettings BatchedThrobberSettings;
+
 	/** Image Sequence settings. Ignore this if you don't choose the 'Image Sequence' icon type*/
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Widget Setting")
 	FImageSequenceSettings ImageSequenceSettings;
@@ -287,6 +420,17 @@ struct ASYNCLOADINGSCREEN_API FLoadingWidgetSettings
 	/** Empty space between the loading text and the loading icon */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loading Widget Setting")
 	float Space = 1.0f;
+
+	/**
+	 * Show a bar with the async loading progress of the level under the loading icon and text.
+	 * The bar shows a marquee until the level package shows up in the async loading queue.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loading Widget Setting")
+	bool bShowProgressBar = false;
+
+	/** Progress bar settings. Ignore this if 'Show Progress Bar' is unchecked */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loading Widget Setting")
+	FProgressBarSettings ProgressBarSettings;
 };
 
 
@@ -387,6 +531,48 @@ struct ASYNCLOADINGSCREEN_API FALoadingScreenSettings
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings")
 	EAsyncLoadingScreenLayout Layout = EAsyncLoadingScreenLayout::ALSL_Classic;
 
+	/**
+	 * If true, the widget overlay is constructed once and reused by the next loading screens as long as the settings don't change.
+	 * Only the background, tip and movie are picked again, the background and loading icon images are still released when the loading screen is gone.
+	 * Off by default, so existing projects keep constructing a new overlay for every loading screen.
+	 * Ignore this if you choose "Show Widget Overlay = false"
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings")
+	bool bReuseWidgetOverlay = false;
+
+	/**
+	 * If true, the static parts of the widget overlay (background, tip, borders) are painted once and cached, only the loading icon is painted every frame.
+	 * Off by default, so existing projects keep painting the whole overlay every frame.
+	 * Ignore this if you choose "Show Widget Overlay = false"
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings")
+	bool bCacheStaticWidgets = false;
+
+	/**
+	 * If true, the layout is painted by a single widget instead of a tree of Slate widgets, which is cheaper to construct and paint on low-end hardware.
+	 * Background image files and image sequence loading icons aren't supported, the regular layout is used for them.
+	 * Ignore this if you choose "Show Widget Overlay = false"
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings")
+	bool bUseLightweightLayout = false;
+
+	/**
+	 * Maximum frame rate of the widget overlay while the loading icon is animating, the Slate loading thread sleeps for the rest of each frame
+	 * so the CPU is left to the loading threads. Zero keeps the movie player's own cap of 60 frames per second.
+	 * The movies are drawn by the same thread, don't set this lower than their frame rate.
+	 * Ignore this if you choose "Show Widget Overlay = false"
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings", meta = (UIMax = 60.00, UIMin = 0.00, ClampMin = "0"))
+	float MaxFrameRate = 0.0f;
+
+	/**
+	 * Maximum frame rate of the widget overlay while nothing is animating, e.g. there is no loading icon or the image sequence has a single frame.
+	 * Zero uses Max Frame Rate.
+	 * Ignore this if you choose "Show Widget Overlay = false"
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings", meta = (UIMax = 60.00, UIMin = 0.00, ClampMin = "0"))
+	float MaxIdleFrameRate = 0.0f;
+
 	/** Background widget for the loading screen. Ignore this if you choose "Show Widget Overlay = false" */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Loading Screen Settings")
 	FBackgroundSettings Background;	
@@ -663,4 +849,19 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Layout")
 	FDualSidebarLayoutSettings DualSidebar;
 
+	/**
+	 * If true, the background and image sequence textures only keep the mips needed for their size on screen in the current viewport,
+	 * e.g. a 4K background on a 720p screen never streams in its top mips. Textures with "Never Stream" enabled always keep all of their mips.
+	 * The limit is applied through the LOD bias of the textures while the loading screen is shown, so the texture streamer respects it.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Texture Streaming")
+	bool bLimitTextureMipsToScreenSize = true;
+
+	/**
+	 * The maximum width or height of the largest resident mip of the loading screen textures, 0 means no limit. 
+	 * Ignore this if you choose "Limit Texture Mips To Screen Size = false".
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Texture Streaming", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxResidentTextureResolution = 0;
+
 };
@@ -0,0 +1,35 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+#include "Engine/EngineTypes.h"
+
+class UTexture2D;
+
+/**
+ * Editor helpers for reading the source images of an image sequence, shared by the flipbook and delta sequence builders
+ */
+struct FLoadingScreenSourceFrames
+{
+	/**
+	 * Collects the source textures from the explicit frame list, or from the folder if the list is empty.
+	 * Textures found in the folder are sorted by the number at the end of their names.
+	 */
+	static void Gather(const TArray<TSoftObjectPtr<UTexture2D>>& SourceFrames, const FDirectoryPath& SourceFolder, TArray<UTexture2D*>& OutFrames);
+
+	/**
+	 * Reads the top mip of the texture source as BGRA8 pixels, G8 sources are expanded.
+	 * Returns false and logs a warning if the size doesn't match or the format isn't supported.
+	 */
+	static bool ReadPixels(UTexture2D* Frame, const FIntPoint& ExpectedSize, TArray64<uint8>& OutPixels);
+};
+#endif
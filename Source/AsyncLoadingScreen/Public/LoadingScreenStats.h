@@ -0,0 +1,61 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LoadingScreenStats.generated.h"
+
+/**
+ * What a loading screen session cost the player, times are in seconds since the loading screen was set up
+ */
+USTRUCT(BlueprintType)
+struct ASYNCLOADINGSCREEN_API FLoadingScreenStats
+{
+	GENERATED_BODY()
+
+	/** Whether a loading screen has been shown since the game started */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	bool bIsValid = false;
+
+	/** Map loaded behind the loading screen, empty if no map load was seen */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	FString MapName;
+
+	/** Time until the widget overlay painted its first frame, negative if it was never painted */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float TimeToFirstPaint = -1.0f;
+
+	/** Time the loading screen was shown for */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float ShownDuration = 0.0f;
+
+	/** Time until the map was loaded, the whole shown duration if no map load was seen */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float LoadingDuration = 0.0f;
+
+	/** Time the loading screen stayed up after the map was loaded because of the Minimum Loading Screen Display Time */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float MinimumDisplayTimeWait = 0.0f;
+
+	/** Number of frames the widget overlay painted */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	int32 NumFrames = 0;
+
+	/** Average time the widget overlay took to paint a frame, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float AveragePaintTimeMs = 0.0f;
+
+	/** Average time between two frames of the widget overlay, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float AverageFrameTimeMs = 0.0f;
+
+	/** Longest time between two frames of the widget overlay, in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Async Loading Screen")
+	float MaxFrameTimeMs = 0.0f;
+};
@@ -0,0 +1,83 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Atomic.h"
+
+class FLoadingScreenAnimatedImage;
+class IImageWrapperModule;
+class UTexture2D;
+
+/**
+ * Streams an animated image file into a single texture. A background decoder keeps a small ring buffer of decoded frames ahead of playback,
+ * so memory doesn't grow with the length of the animation. The texture must outlive the player until Stop() is called.
+ */
+class FLoadingScreenStreamingSequencePlayer : public TSharedFromThis<FLoadingScreenStreamingSequencePlayer, ESPMode::ThreadSafe>
+{
+public:
+	FLoadingScreenStreamingSequencePlayer(IImageWrapperModule& InImageWrapperModule, const FString& InFilePath, UTexture2D* InTexture, int32 InBufferSize);
+
+	/** Starts decoding frames on a worker thread */
+	void Start();
+
+	/**
+	 * Advances playback, the next buffered frame is uploaded to the texture once the current one has been shown for its duration.
+	 * If the decoder fell behind, the current frame stays up until the next one is ready. Returns true if a frame was uploaded.
+	 */
+	bool Tick(float DeltaTime);
+
+	/** Stops decoding and waits for the frame in flight, no frame is decoded or uploaded afterwards */
+	void Stop();
+
+	/** Bytes held by the decoder and the ring buffer, the texture excluded */
+	int64 GetAllocatedSize() const;
+
+private:
+	/** Kicks the decoder if it's idle and there's room in the ring buffer */
+	void KickDecoder();
+
+	/** Decodes frames on the worker thread until the ring buffer is full */
+	void DecodeFrames();
+
+	/** Uploads the frame to the texture, the pixels are freed once the render thread is done with them */
+	void UploadFrame(TArray<uint8>&& Pixels);
+
+private:
+	struct FBufferedFrame
+	{
+		TArray<uint8> Pixels;
+		float Duration = 0.0f;
+	};
+
+	IImageWrapperModule& ImageWrapperModule;
+	FString FilePath;
+	UTexture2D* Texture;
+
+	// Only used by the decoding task
+	TUniquePtr<FLoadingScreenAnimatedImage> Image;
+
+	// Decoded frames waiting to be shown
+	TArray<FBufferedFrame> RingBuffer;
+	int32 ReadIndex = 0;
+	int32 NumBufferedFrames = 0;
+	mutable FCriticalSection RingBufferCS;
+
+	// Playback state, only used by the thread that ticks the player
+	float CurrentFrameTime = 0.0f;
+	float CurrentFrameDuration = 0.0f;
+
+	TAtomic<bool> bIsDecoding { false };
+	TAtomic<bool> bIsStopped { false };
+	TAtomic<bool> bHasFailed { false };
+	TAtomic<int64> DecoderAllocatedSize { 0 };
+	// Held while frames are decoded, so Stop() can wait for them
+	FCriticalSection DecodeCS;
+};
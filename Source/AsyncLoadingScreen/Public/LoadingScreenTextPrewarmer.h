@@ -0,0 +1,75 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Containers/Ticker.h"
+
+struct FALoadingScreenSettings;
+
+/**
+ * Shapes the tip and loading texts and rasterizes their glyphs into the font atlas ahead of the loading screen, so its first frame doesn't have to.
+ * The texts are prewarmed on the game thread ticks, a couple of milliseconds at a time, and only once per culture, font and scale.
+ */
+class FLoadingScreenTextPrewarmer
+{
+public:
+	~FLoadingScreenTextPrewarmer();
+
+	/** Queues every tip and the loading text of the settings for the current culture, they're prewarmed on the next ticks */
+	void Queue(const FALoadingScreenSettings& Settings);
+
+	/** Prewarms whatever is still queued right away */
+	void Flush();
+
+	/** Queues the settings and prewarms the given tip and the loading text right away, the other tips stay queued for the next ticks */
+	void Flush(const FALoadingScreenSettings& Settings, int32 TipTextIndex);
+
+private:
+	/** Ticker callback prewarming the queued texts within the time budget */
+	bool Tick(float DeltaTime);
+
+	/** Shapes the next queued text and rasterizes its glyphs */
+	void PrewarmNext();
+
+	/** Adds the text to the queue unless it has already been prewarmed */
+	void QueueText(const FText& Text, const FSlateFontInfo& Font, float FontScale);
+
+	/** Logs how much was prewarmed once the queue is empty */
+	void OnQueueDone();
+
+	/** Whether the settings show any text and Slate can shape it */
+	static bool CanPrewarm(const FALoadingScreenSettings& Settings);
+
+	/** Scale the loading text is painted at for the layout of the settings */
+	static float GetLoadingTextScale(const FALoadingScreenSettings& Settings, float DPIScale);
+
+	/** Hash of the current culture, text, font and scale, identifying what has been prewarmed */
+	static uint32 GetTextKey(const FString& Text, const FSlateFontInfo& Font, float FontScale);
+
+private:
+	struct FQueuedText
+	{
+		FString Text;
+		FSlateFontInfo Font;
+		float FontScale;
+		uint32 Key;
+	};
+
+	TArray<FQueuedText> QueuedTexts;
+	int32 NextQueuedText = 0;
+	// Culture, text, font and scale of everything already prewarmed
+	TSet<uint32> PrewarmedTexts;
+	FDelegateHandle TickerHandle;
+
+	// Statistics of the current queue
+	int32 NumPrewarmedGlyphs = 0;
+	uint64 PrewarmCycles = 0;
+};
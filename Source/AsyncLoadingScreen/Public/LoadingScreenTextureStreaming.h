@@ -0,0 +1,56 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Layout/SScaleBox.h"
+
+class UTexture2D;
+class ULoadingScreenSettings;
+
+/**
+ * Texture memory limits of the loading screen settings, copied on the game thread with the rest of the render plan
+ */
+struct FLoadingScreenTextureLimits
+{
+	/** See ULoadingScreenSettings::bLimitTextureMipsToScreenSize */
+	bool bLimitToScreenSize = true;
+
+	/** See ULoadingScreenSettings::MaxResidentTextureResolution */
+	int32 MaxResolution = 0;
+
+	FLoadingScreenTextureLimits() = default;
+	explicit FLoadingScreenTextureLimits(const ULoadingScreenSettings& Settings);
+};
+
+/**
+ * Helpers to only keep the texture mips that the loading screen actually displays
+ */
+struct FLoadingScreenTextureStreaming
+{
+	/** Size of the game viewport, falls back to the primary display size if there's no viewport yet */
+	static FVector2D GetViewportSize();
+
+	/** Scale of the texture on screen when it's stretched into the given area */
+	static float GetStretchScale(EStretch::Type Stretch, const FVector2D& TextureSize, const FVector2D& AreaSize);
+
+	/** Scale of the UI on screen for the current viewport */
+	static float GetViewportDPIScale();
+
+	/**
+	 * Limits the texture to the mips needed to draw it at the given scale, capped by the max resolution of the limits.
+	 * The texture streamer recomputes the wanted mips on its own, so the limit goes through the LOD bias of the texture, which the streamer
+	 * respects, until RestoreResidentMips is called. Does nothing for textures that can't be streamed, nor in the editor where the LOD bias
+	 * could be saved with the texture. Has to be called on the game thread.
+	 */
+	static void UpdateResidentMips(UTexture2D* Texture, float ScreenScale, const FLoadingScreenTextureLimits& Limits);
+
+	/** Gives every limited texture its own LOD bias back, called on the game thread when the loading screen is gone */
+	static void RestoreResidentMips();
+};
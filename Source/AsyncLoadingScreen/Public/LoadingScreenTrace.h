@@ -0,0 +1,94 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Templates/Atomic.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "AsyncLoadingScreen.h"
+
+/**
+ * Instrumentation of the plugin. "stat AsyncLoadingScreen" shows the cycle stats and counters, and the same scopes show up in
+ * Unreal Insights on the AsyncLoadingScreen trace channel, e.g. with -trace=cpu,AsyncLoadingScreen.
+ */
+UE_TRACE_CHANNEL_EXTERN(AsyncLoadingScreenChannel, ASYNCLOADINGSCREEN_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Widgets"), STAT_LiveWidgets, STATGROUP_AsyncLoadingScreen, ASYNCLOADINGSCREEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Brushes"), STAT_LiveBrushes, STATGROUP_AsyncLoadingScreen, ASYNCLOADINGSCREEN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Brush Swaps"), STAT_BrushSwaps, STATGROUP_AsyncLoadingScreen, ASYNCLOADINGSCREEN_API);
+
+/**
+ * Low Level Memory tracker tag of everything the plugin allocates or loads: widget trees, brushes, decoded images and fonts.
+ * It shows up as AsyncLoadingScreen in "stat LLM" and the LLM CSV when running with -llm. It takes the last project tag by default, set
+ * LLMTag in the [/Script/AsyncLoadingScreen.MemoryTracking] section of DefaultEngine.ini to move it. If that project tag is already
+ * registered, the plugin doesn't register it again and its memory is tracked under the UI tag instead.
+ */
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+ASYNCLOADINGSCREEN_API ELLMTag GetAsyncLoadingScreenLLMTag();
+#define LLM_TAG_ASYNC_LOADING_SCREEN GetAsyncLoadingScreenLLMTag()
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("AsyncLoadingScreen"), STAT_AsyncLoadingScreenLLM, STATGROUP_LLMFULL, ASYNCLOADINGSCREEN_API);
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("AsyncLoadingScreen"), STAT_AsyncLoadingScreenSummaryLLM, STATGROUP_LLM, ASYNCLOADINGSCREEN_API);
+#define LLM_SCOPE_LOADING_SCREEN() LLM_SCOPE(LLM_TAG_ASYNC_LOADING_SCREEN)
+#else
+#define LLM_SCOPE_LOADING_SCREEN()
+#endif
+
+/** Cycle stat that also emits a scope on the trace channel */
+#define SCOPE_LOADING_SCREEN_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, AsyncLoadingScreenChannel)
+
+/**
+ * Counts the widget it's a member of on the live widget counter for as long as the widget lives
+ */
+struct FLoadingScreenWidgetCounter
+{
+	FLoadingScreenWidgetCounter()
+	{
+		INC_DWORD_STAT(STAT_LiveWidgets);
+	}
+
+	~FLoadingScreenWidgetCounter()
+	{
+		DEC_DWORD_STAT(STAT_LiveWidgets);
+	}
+};
+
+/**
+ * Reports the number of brushes its owner holds to the live brush counter, they're taken off the counter when the owner is destroyed.
+ * The owners call Set after they create, swap or release brushes, from the game thread or the Slate loading thread.
+ */
+struct FLoadingScreenBrushCounter
+{
+	~FLoadingScreenBrushCounter()
+	{
+		Set(0);
+	}
+
+	void Set(int32 NumBrushes)
+	{
+#if STATS
+		const int32 NumCountedBrushes = NumBrushesCounted.Exchange(NumBrushes);
+		if (NumBrushes > NumCountedBrushes)
+		{
+			INC_DWORD_STAT_BY(STAT_LiveBrushes, NumBrushes - NumCountedBrushes);
+		}
+		else if (NumBrushes < NumCountedBrushes)
+		{
+			DEC_DWORD_STAT_BY(STAT_LiveBrushes, NumCountedBrushes - NumBrushes);
+		}
+#endif
+	}
+
+private:
+	TAtomic<int32> NumBrushesCounted { 0 };
+};
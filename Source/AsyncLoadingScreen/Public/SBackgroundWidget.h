@@ -9,9 +9,12 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "LoadingScreenTrace.h"
+#include "LoadingScreenTextureStreaming.h"
 
 struct FBackgroundSettings;
-class FDeferredCleanupSlateBrush;
+class FLoadingScreenBackgroundLoader;
+class SImage;
 
 /**
  * Background widget
@@ -21,10 +24,34 @@ class SBackgroundWidget : public SCompoundWidget
 public:
 	SLATE_BEGIN_ARGS(SBackgroundWidget) {}
 
+	/** Texture memory limits of the render plan */
+	SLATE_ARGUMENT(FLoadingScreenTextureLimits, TextureLimits)
+
 	SLATE_END_ARGS()
 
+	virtual ~SBackgroundWidget();
+
 	void Construct(const FArguments& InArgs, const FBackgroundSettings& Settings);
 
+	/** Picks a new background image and requests it, so the widget can be reused by the next loading screen */
+	void Rebind();
+
+	/** Releases the background image while the loading screen isn't shown */
+	void ReleaseImage();
+
 private:
-	TSharedPtr<FDeferredCleanupSlateBrush> ImageBrush;
+	/** Picks the background image and requests it */
+	void RequestBackgroundImage();
+
+	/** Active timer event for swapping the loaded background brush into the image widget */
+	EActiveTimerReturnType UpdateBackgroundImage(double InCurrentTime, float InDeltaTime);
+
+private:
+	// Loads the background image and owns its brush
+	TSharedPtr<FLoadingScreenBackgroundLoader, ESPMode::ThreadSafe> BackgroundLoader;
+	// Image widget displaying the background brush
+	TSharedPtr<SImage> Image;
+	bool bIsActiveTimerRegistered = false;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
 };
@@ -0,0 +1,95 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Widgets/SLeafWidget.h"
+#include "Rendering/RenderingCommon.h"
+#include "Rendering/SlateResourceHandle.h"
+#include "LoadingScreenSettings.h"
+#include "LoadingScreenTrace.h"
+
+/**
+ * Geometry of a circular throbber built as a single batch of vertices.
+ * The angle and trail of every piece are worked out once, each paint only rotates them by the phase, four pieces at a time,
+ * and the whole throbber goes to the renderer as one draw element instead of one box per piece.
+ */
+class FBatchedThrobberGeometry
+{
+public:
+	/** Precomputes the tables for the settings */
+	void Initialize(const FBatchedThrobberSettings& InSettings);
+
+	/** Paints every piece for the time in one draw element */
+	int32 Paint(const FGeometry& AllottedGeometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const;
+
+	/** Size of the whole throbber */
+	FVector2D GetDesiredSize() const;
+
+	/** Whether there is anything to paint */
+	bool HasPieces() const { return NumPieces > 0; }
+
+private:
+	/** Looks up the resource of the piece image and its texture coordinates */
+	void UpdateResourceHandle() const;
+
+private:
+	FBatchedThrobberSettings Settings;
+	int32 NumPieces = 0;
+
+	// Per piece tables, padded with zeros to a multiple of four pieces so they can be evaluated four at a time
+	TArray<float> BaseCos;
+	TArray<float> BaseSin;
+	TArray<float> PieceScales;
+	TArray<float> PieceOpacities;
+
+	// Two triangles per piece, the indices never change
+	TArray<SlateIndex> Indices;
+
+	// Scratch buffers reused by every paint
+	mutable TArray<float> CenterX;
+	mutable TArray<float> CenterY;
+	mutable TArray<float> HalfWidth;
+	mutable TArray<float> HalfHeight;
+	mutable TArray<FSlateVertex> Vertices;
+
+	// Resource of the piece image and where the image is in it
+	mutable FSlateResourceHandle ResourceHandle;
+	mutable FVector2D StartUV = FVector2D::ZeroVector;
+	mutable FVector2D SizeUV = FVector2D::UnitVector;
+};
+
+/**
+ * Circular throbber painting all its pieces in one draw call
+ */
+class SBatchedThrobber : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SBatchedThrobber) {}
+
+	SLATE_END_ARGS()
+
+	/**
+	 * Construct this widget
+	 */
+	void Construct(const FArguments& InArgs, const FBatchedThrobberSettings& Settings);
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float) const override;
+	// End of SWidget interface
+
+private:
+	/** Active timer event repainting the throbber every frame */
+	EActiveTimerReturnType AnimateThrobber(double InCurrentTime, float InDeltaTime);
+
+private:
+	FBatchedThrobberGeometry ThrobberGeometry;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
+};
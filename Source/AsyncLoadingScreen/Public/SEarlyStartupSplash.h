@@ -0,0 +1,76 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Layout/SScaleBox.h"
+#include "Templates/Atomic.h"
+#include "LoadingScreenImageDecoder.h"
+#include "LoadingScreenTrace.h"
+
+struct FSlateDynamicImageBrush;
+class SImage;
+
+/**
+ * Settings of the early startup splash. These are read straight from the [/Script/AsyncLoadingScreen.EarlyStartupSplash]
+ * section of DefaultGame.ini, so showing the splash doesn't construct ULoadingScreenSettings and load the assets it references.
+ * The module still loads in the PreLoadingScreen phase, the splash is set up at the same point as the "Startup Loading Screen".
+ */
+struct FEarlyStartupSplashSettings
+{
+	// Show the splash instead of the "Startup Loading Screen", its movies and widget overlay are skipped
+	bool bEnabled = false;
+	// Directory with the PNG/JPEG files, relative to the project content directory. Add it to "Additional Non-Asset Directories to Copy" so it's staged
+	FString ImageDirectory = TEXT("Splash");
+	// Pick a random image from the directory instead of the first one
+	bool bRandomImage = false;
+	FLinearColor BackgroundColor = FLinearColor::Black;
+	EStretch::Type ImageStretch = EStretch::ScaleToFit;
+	float MinimumDisplayTime = -1.0f;
+
+	/** Reads the settings from the game config */
+	static FEarlyStartupSplashSettings Load();
+};
+
+/**
+ * Splash widget for the early startup loading screen. It doesn't use any UObject, the image file is decoded on a worker thread
+ * and turned into a dynamic image brush on the game thread, the widget only swaps the finished brush in.
+ */
+class SEarlyStartupSplash : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SEarlyStartupSplash) {}
+
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const FEarlyStartupSplashSettings& Settings);
+
+private:
+	/** Active timer event for showing the brush once it's created */
+	EActiveTimerReturnType UpdateSplashImage(double InCurrentTime, float InDeltaTime);
+
+private:
+	/** State shared with the decoding thread, so the widget can go away while it's still decoding */
+	struct FDecodeState
+	{
+		FLoadingScreenDecodedImage Image;
+		FString FilePath;
+		// Created on the game thread from the decoded pixels, handed over when bDone is set
+		TSharedPtr<FSlateDynamicImageBrush> Brush;
+		TAtomic<bool> bDone { false };
+	};
+
+	TSharedPtr<FDecodeState, ESPMode::ThreadSafe> DecodeState;
+	TSharedPtr<FSlateDynamicImageBrush> ImageBrush;
+	// Image widget displaying the splash brush
+	TSharedPtr<SImage> Image;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
+	FLoadingScreenBrushCounter BrushCounter;
+};
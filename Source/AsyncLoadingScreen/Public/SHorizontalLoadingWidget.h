@@ -20,6 +20,9 @@ class SHorizontalLoadingWidget : public SLoadingWidget
 public:
 	SLATE_BEGIN_ARGS(SHorizontalLoadingWidget) {}
 
+	/** Texture memory limits of the render plan */
+	SLATE_ARGUMENT(FLoadingScreenTextureLimits, TextureLimits)
+
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const FLoadingWidgetSettings& Settings);
@@ -10,9 +10,6 @@
 
 #include "SLoadingScreenLayout.h"
 
-struct FALoadingScreenSettings;
-struct FLetterboxLayoutSettings;
-
 /**
  * Letterbox layout loading screen
  */
@@ -26,5 +23,5 @@ public:
 	/**
 	 * Construct this widget
 	 */
-	void Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FLetterboxLayoutSettings& LayoutSettings);
+	void Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan);
 };
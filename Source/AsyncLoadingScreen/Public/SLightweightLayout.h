@@ -0,0 +1,191 @@
+/************************************************************************************
+ *																					*
+ * Copyright (C) 2020 Truong Bui.													*
+ * Website:	https://github.com/truong-bui/AsyncLoadingScreen						*
+ * Licensed under the MIT License. See 'LICENSE' file for full license information. *
+ *																					*
+ ************************************************************************************/
+
+#pragma once
+
+#include "SLoadingScreenLayout.h"
+#include "Containers/Array.h"
+#include "LoadingScreenSettings.h"
+#include "SBatchedThrobber.h"
+
+class FLoadingScreenBackgroundLoader;
+class FLoadingScreenProgress;
+
+/**
+ * Lightweight loading screen. A single widget arranges the background, tip and loading widget the same way the selected layout does,
+ * only when its size changes, and paints them directly instead of constructing a tree of Slate widgets.
+ * Background image files and image sequence loading icons aren't supported, see CanRender.
+ */
+class SLightweightLayout : public SLoadingScreenLayout
+{
+public:
+	SLATE_BEGIN_ARGS(SLightweightLayout) {}
+
+	SLATE_END_ARGS()
+
+	/**
+	 * Construct this widget
+	 */
+	void Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan);
+
+	/** Whether the lightweight layout can paint everything the loading screen settings use */
+	static bool CanRender(const FALoadingScreenSettings& Settings);
+
+	// SLoadingScreenLayout interface
+	virtual void Rebind() override;
+	virtual void ReleaseResources() override;
+	virtual bool IsAnimating() const override;
+	// End of SLoadingScreenLayout interface
+
+protected:
+	// SLoadingScreenLayout interface
+	virtual int32 PaintLayout(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	// End of SLoadingScreenLayout interface
+
+private:
+	/** What a panel slot shows */
+	enum class ESlotContent : uint8
+	{
+		LoadingWidget,
+		Tip
+	};
+
+	/** Slot of a panel, the equivalent of a box panel slot */
+	struct FPanelSlot
+	{
+		ESlotContent Content;
+		EHorizontalAlignment HAlign;
+		EVerticalAlignment VAlign;
+		// Takes the space left in the panel instead of its desired size
+		bool bFill;
+	};
+
+	/** Panel of the layout, the equivalent of SBorder > SSafeZone > SDPIScaler > box panel */
+	struct FPanel
+	{
+		// Border brush, the panel has no border if it's not set
+		TOptional<FSlateBrush> Border;
+		// Alignment and offset of the panel on screen
+		EHorizontalAlignment HAlign = HAlign_Fill;
+		EVerticalAlignment VAlign = VAlign_Fill;
+		FMargin Offset;
+		// Padding inside the border, the title safe area is added to it
+		FMargin Padding;
+		bool bTitleSafe = true;
+		// Whether the slots are scaled with the UI scale
+		bool bDPIScaled = true;
+		// Alignment of the slots inside the padding
+		EHorizontalAlignment ContentHAlign = HAlign_Fill;
+		EVerticalAlignment ContentVAlign = VAlign_Fill;
+		// How the slots are stacked and the space between them
+		EOrientation Orientation = Orient_Horizontal;
+		float Space = 0.0f;
+		TArray<FPanelSlot, TInlineAllocator<2>> Slots;
+	};
+
+	/** Text broken into lines */
+	struct FWrappedText
+	{
+		TArray<FString> Lines;
+		TArray<float> LineWidths;
+		FVector2D Size = FVector2D::ZeroVector;
+		float LineHeight = 0.0f;
+	};
+
+	/** Position and size of an element in the layout space, and the scale it's painted at */
+	struct FArrangedBox
+	{
+		FVector2D Position = FVector2D::ZeroVector;
+		FVector2D Size = FVector2D::ZeroVector;
+		float Scale = 1.0f;
+	};
+
+	/** Adds the panels of the selected layout */
+	void AddPanels(const FClassicLayoutSettings& LayoutSettings);
+	void AddPanels(const FCenterLayoutSettings& LayoutSettings);
+	void AddPanels(const FLetterboxLayoutSettings& LayoutSettings);
+	void AddPanels(const FSidebarLayoutSettings& LayoutSettings);
+	void AddPanels(const FDualSidebarLayoutSettings& LayoutSettings);
+
+	/** Picks the tip text and breaks it into lines */
+	void PickTipText();
+
+	/** Picks the background image and requests it */
+	void RequestBackgroundImage();
+
+	/** Active timer event for swapping the loaded background brush in */
+	EActiveTimerReturnType UpdateBackgroundImage(double InCurrentTime, float InDeltaTime);
+
+	/** Breaks the text into lines no wider than WrapAt, zero only breaks at line feeds */
+	static FWrappedText WrapText(const FText& Text, const FSlateFontInfo& Font, float WrapAt);
+
+	/** Unscaled desired size of the slot content */
+	FVector2D GetSlotDesiredSize(ESlotContent Content) const;
+
+	/** Unscaled desired size of the loading icon and loading text, without the progress bar */
+	FVector2D GetLoadingContentSize() const;
+
+	/** Unscaled desired size of the loading icon */
+	FVector2D GetLoadingIconSize() const;
+
+	/** Works out where every element goes for the size of the layout */
+	void Arrange(const FVector2D& Size, float DPIScale) const;
+
+	/** Works out where the loading icon, loading text and progress bar go inside the loading widget */
+	void ArrangeLoadingWidget(const FArrangedBox& InBox) const;
+
+	/** Paints the lines of text with its shadow */
+	int32 PaintText(const FGeometry& Geometry, const FWrappedText& Text, const FTextAppearance& Appearance, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const;
+
+	/** Paints the throbber pieces for the time */
+	int32 PaintLoadingIcon(const FGeometry& Geometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const;
+
+	/** Paints the progress bar with the latest load progress */
+	int32 PaintProgressBar(const FGeometry& Geometry, double CurrentTime, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle) const;
+
+private:
+	TArray<FPanel> Panels;
+
+	// Background settings and the loader of the background image
+	TSharedPtr<FLoadingScreenBackgroundLoader, ESPMode::ThreadSafe> BackgroundLoader;
+	EStretch::Type BackgroundStretch = EStretch::ScaleToFit;
+	FMargin BackgroundPadding;
+	FLinearColor BackgroundColor = FLinearColor::Black;
+
+	// Tip settings and the tip picked for this loading screen
+	TArray<FText> TipTexts;
+	bool bSetDisplayTipTextManually = false;
+	FTextAppearance TipAppearance;
+	float TipWrapAt = 0.0f;
+	FWrappedText TipText;
+
+	// Loading widget settings
+	FLoadingWidgetSettings LoadingWidgetSettings;
+	FWrappedText LoadingText;
+	FBatchedThrobberGeometry BatchedThrobber;
+
+	// Load progress published by the game thread, and the value the bar shows
+	TSharedPtr<FLoadingScreenProgress, ESPMode::ThreadSafe> LoadingProgress;
+	mutable float DisplayedProgress = -1.0f;
+	mutable double LastProgressUpdateTime = 0.0;
+
+	// Title safe area of the display
+	FMargin SafeMargin;
+
+	bool bIsActiveTimerRegistered = false;
+
+	// Size the elements were last arranged for
+	mutable FVector2D ArrangedSize = FVector2D(-1.0f, -1.0f);
+	mutable float ArrangedDPIScale = 0.0f;
+	// Arranged borders, one per panel, and contents
+	mutable TArray<FArrangedBox> ArrangedBorders;
+	mutable FArrangedBox ArrangedLoadingIcon;
+	mutable FArrangedBox ArrangedLoadingText;
+	mutable FArrangedBox ArrangedProgressBar;
+	mutable FArrangedBox ArrangedTip;
+};
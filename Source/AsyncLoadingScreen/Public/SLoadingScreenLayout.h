@@ -9,6 +9,17 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Curves/RichCurve.h"
+#include "LoadingScreenRenderPlan.h"
+#include "LoadingScreenTrace.h"
+
+class SBackgroundWidget;
+class STipWidget;
+class SLoadingWidget;
+struct FBackgroundSettings;
+struct FTipSettings;
+struct FLoadingWidgetSettings;
+struct FALoadingScreenSettings;
 
 /**
  * Loading screen base theme
@@ -16,7 +27,116 @@
 class SLoadingScreenLayout : public SCompoundWidget
 {
 public:	
+	SLoadingScreenLayout();
+
 	static float PointSizeToSlateUnits(float PointSize);
+
+	/** Picks a new background and tip, and requests the released images again, so the layout can be reused by the next loading screen */
+	virtual void Rebind();
+
+	/** Releases the images held by the layout while the loading screen isn't shown */
+	virtual void ReleaseResources();
+
+	/** Whether anything in the layout changes from frame to frame */
+	virtual bool IsAnimating() const;
+
+	/** Caps the frame rate of the Slate loading thread while the layout is shown, zero leaves it uncapped */
+	void SetMaxFrameRate(float InMaxFrameRate, float InMaxIdleFrameRate);
+
+	/** Paint statistics since the loading screen was shown, reset by ReleaseResources */
+	struct FFrameStats
+	{
+		int32 NumFrames = 0;
+		// When the first frame was painted, in FPlatformTime::Seconds
+		double FirstPaintTime = 0.0;
+		double AveragePaintTimeMs = 0.0;
+		double AverageFrameTimeMs = 0.0;
+		double MaxFrameTimeMs = 0.0;
+	};
+
+	/** Gets the paint statistics, only meaningful once the loading thread stopped painting the layout */
+	FFrameStats GetFrameStats() const;
+
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	// End of SWidget interface
+
 protected:
+	/** Paints the layout, the default paints the child widgets */
+	virtual int32 PaintLayout(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const;
+
+	/** DPI scale for the current size of the layout, only evaluated again when the size changes */
 	float GetDPIScale() const;	
+
+	/** Constructs the background widget */
+	TSharedRef<SWidget> ConstructBackgroundWidget(const FBackgroundSettings& Settings);
+
+	/** Constructs the tip widget */
+	TSharedRef<SWidget> ConstructTipWidget(const FTipSettings& Settings);
+
+	/** Constructs the horizontal or vertical loading widget */
+	TSharedRef<SWidget> ConstructLoadingWidget(const FLoadingWidgetSettings& Settings);
+
+	/** Wraps the layout in an invalidation panel if the static widgets are cached, the loading icon is the only volatile widget */
+	TSharedRef<SWidget> ConstructStaticLayer(const TSharedRef<SWidget>& Content, const FALoadingScreenSettings& Settings);
+
+protected:
+	// Settings snapshot the layout was constructed from, the widgets point into it so it lives as long as the layout
+	TSharedPtr<const FLoadingScreenRenderPlan, ESPMode::ThreadSafe> RenderPlan;
+
+	TSharedPtr<SBackgroundWidget> BackgroundWidget;
+	TSharedPtr<STipWidget> TipWidget;
+	TSharedPtr<SLoadingWidget> LoadingWidget;
+
+private:
+	/** Copies the UI scale settings on the game thread, so the loading thread never reads the UUserInterfaceSettings object */
+	void SnapshotDPIScaleSettings();
+
+	/** Evaluates the copied UI scale settings for the size */
+	float EvaluateDPIScale(const FIntPoint& Size) const;
+
+	/** Active timer event sleeping out the rest of the frame on the Slate loading thread */
+	EActiveTimerReturnType LimitFrameRate(double InCurrentTime, float InDeltaTime);
+
+private:
+	/** Which side of the size is evaluated on the DPI curve */
+	enum class EDPIScaleAxis : uint8
+	{
+		ShortestSide,
+		LongestSide,
+		Horizontal,
+		Vertical,
+		// Rules that need the settings object, the scale is evaluated on the game thread for the viewport size
+		Fixed
+	};
+
+	// Copy of the UI scale settings
+	FRichCurve DPIScaleCurve;
+	EDPIScaleAxis DPIScaleAxis = EDPIScaleAxis::ShortestSide;
+	float ApplicationScale = 1.0f;
+	float FixedDPIScale = 1.0f;
+
+	// DPI scale of the last size the layout had
+	mutable FIntPoint CachedDPIScaleSize = FIntPoint(-1, -1);
+	mutable float CachedDPIScale = 1.0f;
+
+	// Paint statistics since the loading screen was shown, logged when it's gone
+	mutable int32 NumPaints = 0;
+	mutable int64 NumPaintElements = 0;
+	mutable uint64 PaintCycles = 0;
+	mutable double FirstPaintTime = 0.0;
+	mutable double LastPaintTime = 0.0;
+	mutable double MaxPaintInterval = 0.0;
+	bool bCacheStaticWidgets = false;
+
+	// Frame rate caps while the loading icon is animating and while it isn't
+	float MaxFrameRate = 0.0f;
+	float MaxIdleFrameRate = 0.0f;
+	bool bIsFrameRateTimerRegistered = false;
+	// End of the last frame, and how long the loading thread slept to hold the cap since the loading screen was shown
+	double LastFrameTime = 0.0;
+	double FrameRateSleepTime = 0.0;
+	int32 NumCappedFrames = 0;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
 };
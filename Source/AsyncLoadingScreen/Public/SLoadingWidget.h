@@ -10,9 +10,23 @@
 
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Images/SThrobber.h"
+#include "HAL/CriticalSection.h"
+#include "Styling/SlateBrush.h"
+#include "LoadingScreenTrace.h"
+#include "LoadingScreenTextureStreaming.h"
 
 class FDeferredCleanupSlateBrush;
+class UTexture2D;
+class ULoadingScreenFlipbook;
+class ULoadingScreenDeltaSequence;
+class FLoadingScreenDeltaSequencePlayer;
+class FLoadingScreenStreamingSequencePlayer;
+class SImage;
+class SProgressBar;
+class STextBlock;
+class FLoadingScreenProgress;
 struct FLoadingWidgetSettings;
+struct FStreamableHandle;
 
 /**
  * Loading Widget base class
@@ -20,6 +34,8 @@ struct FLoadingWidgetSettings;
 class SLoadingWidget : public SCompoundWidget
 {
 public:
+	virtual ~SLoadingWidget();
+
 	/** Active timer event for animating the image sequence */
 	EActiveTimerReturnType AnimatingImageSequence(double InCurrentTime, float InDeltaTime);
 
@@ -29,6 +45,65 @@ public:
 	/** Construct loading icon*/
 	void ConstructLoadingIcon(const FLoadingWidgetSettings& Settings);
 
+	/** Requests the image sequence again if it was released, so the widget can be reused by the next loading screen */
+	void Rebind();
+
+	/** Releases the image sequence textures so they can be garbage collected */
+	void ReleaseImageSequence();
+
+	/** Makes the loading icon paint every frame when it's inside an invalidation panel */
+	void SetLoadingIconVolatile(bool bVolatile);
+
+	/** Whether the loading icon changes from frame to frame */
+	bool IsAnimating() const;
+
+protected:
+	/** Stacks the progress bar under the loading icon and text if the settings show one */
+	TSharedRef<SWidget> ConstructProgressBar(const TSharedRef<SWidget>& Content, const FLoadingWidgetSettings& Settings);
+
+private:
+	/** Active timer event moving the progress bar to the latest load progress */
+	EActiveTimerReturnType UpdateProgressBar(double InCurrentTime, float InDeltaTime);
+
+	/** Requests the image sequence from the streamable manager and starts animating it */
+	void RequestImageSequence();
+
+	/** Called on the game thread when all the images of the sequence have been streamed in */
+	void OnImageSequenceLoaded();
+
+	/** Polls the image sequence request while the game thread is blocked flushing async loading, e.g. in LoadMap */
+	void OnAsyncLoadingFlushUpdate();
+
+	/** Unbinds the flush update polling */
+	void StopPolling();
+
+	/** Creates the image sequence brushes, they will be swapped in on the next active timer update */
+	void SetPendingImageSequence(const TArray<UTexture2D*>& Images);
+
+	/** Sets up the flipbook brush and frame regions, they will be swapped in on the next active timer update */
+	void SetPendingFlipbook(const ULoadingScreenFlipbook* Flipbook);
+
+	/** Creates the delta sequence texture and player, they will be swapped in on the next active timer update */
+	void SetPendingDeltaSequence(const ULoadingScreenDeltaSequence* DeltaSequence);
+
+	/** Swaps in the pending image sequence or flipbook. Returns true if there was anything to swap in */
+	bool ApplyPendingImageSequence();
+
+	/** Creates the texture for the animated image file and starts streaming its frames into it */
+	void StartStreamingSequence();
+
+	/** Number of frames of the image sequence or flipbook */
+	int32 GetNumImageSequenceFrames() const;
+
+	/** Displays the given frame of the image sequence or flipbook */
+	void SetImageSequenceFrame(int32 FrameIndex);
+
+	/** Blends the given frame over the current one, Alpha is how far playback is between the two */
+	void SetCrossFadeFrame(int32 FrameIndex, float Alpha);
+
+	/** Reports the image sequence brushes held, pending ones included, to the live brush counter */
+	void UpdateBrushCounter();
+
 protected:
 	// Placeholder widgets
 	TSharedRef<SWidget> LoadingIcon = SNullWidget::NullWidget;
@@ -40,5 +115,76 @@ protected:
 	bool bPlayReverse = false;
 
 	bool bIsActiveTimerRegistered = false;
-	
+
+private:
+	// The image sequence textures, flipbook or delta sequence to request
+	TArray<FSoftObjectPath> ImageSequenceAssets;
+	// Playback speed of the image sequence, always greater than zero
+	float ImageSequenceFramesPerSecond = 20.0f;
+	// Time the current image sequence started playing, negative until its first update
+	double PlaybackStartTime = -1.0;
+	// Image showing the current frame of the image sequence
+	TSharedPtr<SImage> IconImage;
+	// Whether the loading icon is one of the throbbers
+	bool bIsThrobber = false;
+	// Image blending the next frame over the current one, only created when cross-fading
+	TSharedPtr<SImage> CrossFadeImage;
+	// Frame shown by the cross-fade image and its brush when animating a flipbook
+	int32 CrossFadeIndex = INDEX_NONE;
+	FSlateBrush CrossFadeFlipbookBrush;
+	// Handle of the image sequence load request, keeps the textures alive while the loading screen is shown
+	TSharedPtr<FStreamableHandle> ImageSequenceHandle;
+	// Bound to FCoreDelegates::OnAsyncLoadingFlushUpdate while the image sequence request is in flight
+	FDelegateHandle FlushUpdateHandle;
+	// Scale of the image sequence brushes
+	FVector2D ImageSequenceScale = FVector2D(1.0f, 1.0f);
+	// Scale of the image sequence textures on screen, used to work out which mips are visible
+	float ImageSequenceScreenScale = 1.0f;
+	// Texture memory limits the image sequence textures are streamed in with
+	FLoadingScreenTextureLimits TextureLimits;
+	// Resident size of the image sequence textures, in bytes
+	int64 ImageSequenceResourceSize = 0;
+	// Whether the image sequence is animated from a flipbook atlas
+	bool bUseFlipbook = false;
+	// Single brush on the flipbook atlas, animated by changing its UV region
+	FSlateBrush FlipbookBrush;
+	// UV region of each flipbook frame
+	TArray<FBox2D> FlipbookFrameRegions;
+	// Whether the image sequence is decoded from a delta sequence
+	bool bUseDeltaSequence = false;
+	// Brush on the texture the delta sequence is decoded into, and the player decoding it
+	TSharedPtr<FDeferredCleanupSlateBrush> DeltaSequenceBrush;
+	TSharedPtr<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe> DeltaSequencePlayer;
+	// Whether the image sequence is streamed from an animated image file
+	bool bUseStreamingSequence = false;
+	// Absolute path of the animated image file and how many frames are decoded ahead
+	FString StreamingSequenceFile;
+	int32 StreamingBufferFrames = 4;
+	// Brush on the texture the animated image file is streamed into, and the player streaming it
+	TSharedPtr<FDeferredCleanupSlateBrush> StreamingSequenceBrush;
+	TSharedPtr<FLoadingScreenStreamingSequencePlayer, ESPMode::ThreadSafe> StreamingSequencePlayer;
+	// Bar showing the load progress, only created if the settings show one
+	TSharedPtr<SProgressBar> ProgressBar;
+	// Text showing the expected time left, its format and the number of seconds it shows
+	TSharedPtr<STextBlock> RemainingTimeText;
+	FText RemainingTimeFormat;
+	int32 DisplayedRemainingSeconds = INDEX_NONE;
+	// Load progress published by the game thread, and the value the bar shows
+	TSharedPtr<FLoadingScreenProgress, ESPMode::ThreadSafe> LoadingProgress;
+	float DisplayedProgress = -1.0f;
+
+	// Brushes created on the game thread, waiting to be swapped in by the Slate loading thread
+	TArray<TSharedPtr<FDeferredCleanupSlateBrush>> PendingBrushList;
+	// Flipbook brush and frame regions set up on the game thread, waiting to be swapped in by the Slate loading thread
+	FSlateBrush PendingFlipbookBrush;
+	TArray<FBox2D> PendingFlipbookFrameRegions;
+	// Delta sequence brush and player set up on the game thread, waiting to be swapped in by the Slate loading thread
+	TSharedPtr<FDeferredCleanupSlateBrush> PendingDeltaSequenceBrush;
+	TSharedPtr<FLoadingScreenDeltaSequencePlayer, ESPMode::ThreadSafe> PendingDeltaSequencePlayer;
+	// Whether the image sequence request is still in flight
+	bool bIsImageSequenceLoading = false;
+	FCriticalSection PendingBrushListCS;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
+	FLoadingScreenBrushCounter BrushCounter;
 };
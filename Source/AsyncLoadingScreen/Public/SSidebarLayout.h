@@ -10,9 +10,6 @@
 
 #include "SLoadingScreenLayout.h"
 
-struct FALoadingScreenSettings;
-struct FSidebarLayoutSettings;
-
 /**
  * Sidebar layout loading screen
  */
@@ -26,5 +23,5 @@ public:
 	/**
 	 * Construct this widget
 	 */
-	void Construct(const FArguments& InArgs, const FALoadingScreenSettings& Settings, const FSidebarLayoutSettings& LayoutSettings);
+	void Construct(const FArguments& InArgs, const FLoadingScreenRenderPlanRef& InRenderPlan);
 };
@@ -9,8 +9,10 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "LoadingScreenTrace.h"
 
 struct FTipSettings;
+class STextBlock;
 
 /**
  * Tip widget
@@ -23,4 +25,20 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const FTipSettings& Settings);
+
+	/** Picks a new tip text, so the widget can be reused by the next loading screen */
+	void Rebind();
+
+private:
+	/** Picks the index of the tip text to display */
+	int32 GetTipIndex() const;
+
+private:
+	// The tip texts to choose from
+	TArray<FText> TipTexts;
+	bool bSetDisplayTipTextManually = false;
+	// Text block displaying the tip
+	TSharedPtr<STextBlock> TipTextBlock;
+
+	FLoadingScreenWidgetCounter WidgetCounter;
 };
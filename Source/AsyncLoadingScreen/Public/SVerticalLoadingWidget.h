@@ -18,6 +18,9 @@ class SVerticalLoadingWidget : public SLoadingWidget
 public:
 	SLATE_BEGIN_ARGS(SVerticalLoadingWidget) {}
 
+	/** Texture memory limits of the render plan */
+	SLATE_ARGUMENT(FLoadingScreenTextureLimits, TextureLimits)
+
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const FLoadingWidgetSettings& Settings);